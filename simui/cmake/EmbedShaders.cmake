@@ -0,0 +1,31 @@
+# Turn every file of SHADER_DIR into a null-terminated char array of OUTPUT_FILE, named after the file:
+# `shaders/text.vert` becomes `gSiShader_text_vert`. Run in script mode by the build, so that editing a shader
+# regenerates the file:
+#
+#   cmake -DSHADER_DIR=<dir> -DOUTPUT_FILE=<file> -P EmbedShaders.cmake
+
+if (NOT SHADER_DIR OR NOT OUTPUT_FILE)
+    message(FATAL_ERROR "EmbedShaders.cmake needs SHADER_DIR and OUTPUT_FILE.")
+endif()
+
+file(
+    GLOB
+    SHADER_FILES
+    "${SHADER_DIR}/*"
+)
+list(SORT SHADER_FILES)
+
+set(EMBEDDED_SOURCE "// Generated by cmake/EmbedShaders.cmake from ${SHADER_DIR}, do not edit.\n")
+
+foreach(SHADER_FILE ${SHADER_FILES})
+    get_filename_component(SHADER_NAME ${SHADER_FILE} NAME)
+    string(MAKE_C_IDENTIFIER "gSiShader_${SHADER_NAME}" SHADER_SYMBOL)
+
+    # Bytes rather than a string literal, so the sources need no escaping and MSVC's literal length limit is moot.
+    file(READ ${SHADER_FILE} SHADER_HEX HEX)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," SHADER_BYTES "${SHADER_HEX}")
+
+    string(APPEND EMBEDDED_SOURCE "\nconst char ${SHADER_SYMBOL}[] = {${SHADER_BYTES}0x00};\n")
+endforeach()
+
+file(WRITE ${OUTPUT_FILE} "${EMBEDDED_SOURCE}")
@@ -5,30 +5,66 @@ int main(void)
 {
 	siConfigureCallbacks();
 
-	SiConfig config			= {0};
-	config.fontFile			= SI_STRINGIFY(EXAMPLE_SOURCE_PATH) "/Roboto.ttf";
-	config.fontSizeInPixels = 29.0f;
+	SiConfig config			   = {0};
+	config.fontFile			   = SI_STRINGIFY(EXAMPLE_SOURCE_PATH) "/Roboto.ttf";
+	config.fontSizeInPixels	   = 29.0f;
+	config.skipUnchangedFrames = SI_TRUE;
 
 	siInitialize(config);
 
 	SiTexture texture = readImageFile(SI_STRINGIFY(EXAMPLE_SOURCE_PATH) "/meed-logo.png");
 	SiVector2 texSize = siGetTextureSize(texture);
 
+	// A second size of the same face shares the font file and the glyph atlas with the default font, distance field
+	// glyphs keep the heading crisp however large it is drawn.
+	SiFont headingFont;
+	siFontLoad(config.fontFile, &headingFont, 48.0f, SI_FONT_RASTERIZATION_SDF);
+
+	// The grid never changes, it is recorded once and replayed from GPU memory every frame.
+	SiDrawList grid = siCreateDrawList();
+
 	while (siRunning())
 	{
 		siPollEvents();
 
+		if (!siIsDrawListValid(grid))
+		{
+			siBeginDrawList(grid);
+			for (u32 lineIndex = 0u; lineIndex <= 10u; ++lineIndex)
+			{
+				siDrawRectangle(0.0f, lineIndex * 30.0f, 300.0f, 1.0f, SI_COLOR_WHITE, SI_TEXTURE_NULL);
+				siDrawRectangle(lineIndex * 30.0f, 0.0f, 1.0f, 300.0f, SI_COLOR_WHITE, SI_TEXTURE_NULL);
+			}
+			siDrawText(0.0f, 330.0f, "0.0  1.0  2.0", SI_COLOR_WHITE, &gSiContext.defaultFont);
+			siEndDrawList();
+		}
+
 		siDrawRectangle(600, 600, 300, 300, SI_COLOR_WHITE, texture);
 
 		siDrawRectangle(100, 50, 200, 100, SI_COLOR_WHITE, SI_TEXTURE_NULL);
 
 		siDrawRectangle(110, 100, 200, 100, SI_COLOR_RED, SI_TEXTURE_NULL);
 
+		siDrawRoundedRectangle(1000, 300, 300, 160, SI_COLOR_GREEN, 24.0f, 4.0f);
+
 		siDrawText(120, 150, "Hello, SimUI!", SI_COLOR_WHITE, &gSiContext.defaultFont);
 
+		// UTF-8 text, glyphs outside of ASCII are rasterized into the atlas the first time they are drawn.
+		siDrawText(120,
+				   220,
+				   "25.4 \xC2\xB5m \xC2\xB1 0.1 \xC2\xB0" "C, 4.7 k\xE2\x84\xA6",
+				   SI_COLOR_WHITE,
+				   &gSiContext.defaultFont);
+
+		siDrawText(120, 300, "SimUI", SI_COLOR_WHITE, &headingFont);
+
+		siDrawList(grid, 1400.0f, 500.0f);
+
 		siRender();
 	}
 
+	siDestroyDrawList(grid);
+	siFontUnload(&headingFont);
 	siShutdown();
 	return 0;
 }
\ No newline at end of file
@@ -12,8 +12,99 @@ typedef struct SiConfig
 {
 	const char* fontFile;
 	f32			fontSizeInPixels;
+
+	SiFontRasterization fontRasterization; ///< How the glyphs of the default font are rasterized.
+
+	/**
+	 * Size in bytes of the chunks of the per-frame arena holding the drawing events and their text. `0` selects
+	 * `SI_DEFAULT_FRAME_ARENA_SIZE`. Use `SiFrameStats::arenaHighWaterBytes` to size it so that a frame fits into a
+	 * single chunk.
+	 */
+	u64 frameArenaSize;
+
+	/**
+	 * Opt-in: hash the drawing events of every frame, together with the window size, and skip the frame when the hash
+	 * matches the previous one. A skipped frame generates no geometry and submits nothing, the backend keeps showing
+	 * the last image (`FPN_SiSkipFrame`). Changes the events can not see, like new texture contents, must be reported
+	 * with `siMarkFrameDirty`.
+	 */
+	b8 skipUnchangedFrames;
+
+	/**
+	 * Opt-in: diff the drawing events of every frame against the last rendered frame and only redraw the union of the
+	 * changed areas, the backend keeps the other pixels (`FPN_SiSetDirtyRegion`). Meant for screens where a few
+	 * gauges or counters change per frame. Needs a backend providing `setDirtyRegionFunction`.
+	 */
+	b8 redrawDirtyRegions;
+
+	/**
+	 * Opt-in: before dispatching a frame, drop the primitives outside of the window and the ones fully hidden under a
+	 * later filled, square, untextured rectangle with an alpha of 255. The image is the same, the counts of dropped
+	 * primitives are reported in `SiFrameStats`. Pays off for scrolling canvases and panels drawn over busy content.
+	 */
+	b8 cullHiddenPrimitives;
+
+	/**
+	 * Opt-in: dispatch the primitives grouped by material (shader and texture) instead of in recording order, so that
+	 * interleaved text, rectangles and images, as in the rows of a table, end up in few batches. A primitive is only
+	 * moved ahead of primitives it does not overlap, the image is the same as in recording order.
+	 */
+	b8 reorderForBatching;
+
+	/**
+	 * Time in seconds `siRender` may spend per frame uploading the images decoded by `siLoadImageAsync`. `0` selects
+	 * `SI_DEFAULT_IMAGE_UPLOAD_BUDGET`.
+	 */
+	f64 imageUploadBudgetSeconds;
+
+	/**
+	 * Opt-in: existing directory where `readImageFile` keeps the decoded images, so that later runs map them instead of
+	 * decoding the image files again (see `siSetTextureCacheDirectory`). `SI_NULL` disables the cache.
+	 */
+	const char* textureCacheDirectory;
+
+	/**
+	 * Opt-in: existing directory where the rasterized glyphs of the fonts are kept across runs, so that the glyphs
+	 * drawn at startup are uploaded instead of rasterized again (see `siSetFontCacheDirectory`). `SI_NULL` disables
+	 * the cache.
+	 */
+	const char* fontCacheDirectory;
+
+	/**
+	 * Opt-in: existing directory where the default renderer keeps its linked shader programs (`glGetProgramBinary`),
+	 * keyed by the driver and the shader sources, so that warm starts link nothing. Drivers without program binaries
+	 * compile the sources as usual. `SI_NULL` disables the cache.
+	 */
+	const char* shaderCacheDirectory;
+
+	/**
+	 * Opt-in: render on a dedicated thread owning the graphics context. `siRender` hands the recorded frame over and
+	 * returns, so the next frame is recorded while the previous one is submitted; it only waits when the render thread
+	 * is still busy with the previous frame. `siRender` and `siPollEvents` must still be called on the thread which
+	 * called `siInitialize`. Needs a backend providing `makeContextCurrentFunction`.
+	 */
+	b8 useRenderThread;
 } SiConfig;
 
+#define SI_DEFAULT_FRAME_ARENA_SIZE	   (256u * 1024u)
+#define SI_DEFAULT_IMAGE_UPLOAD_BUDGET 0.002
+
+/**
+ * Statistics about the recorded frames, returned by `siGetFrameStats`.
+ */
+typedef struct SiFrameStats
+{
+	u32 eventCount;			  ///< Number of drawing events recorded in the last rendered frame.
+	u32 eventHighWaterMark;	  ///< The largest number of drawing events recorded in a single frame.
+	u64 arenaUsedBytes;		  ///< Bytes of the frame arena used by the last rendered frame.
+	u64 arenaHighWaterBytes;  ///< The largest number of frame arena bytes used by a single frame.
+	u64 arenaReservedBytes;	  ///< Bytes currently reserved by the frame arena.
+	u64 skippedFrameCount;	  ///< Unchanged frames skipped since `siInitialize`, see `SiConfig::skipUnchangedFrames`.
+	u32 culledOffscreenCount; ///< Off-screen primitives culled in the last frame (`SiConfig::cullHiddenPrimitives`).
+	u32 culledOccludedCount;  ///< Primitives of the last frame culled under a later opaque rectangle.
+	u32 materialGroupCount;	  ///< Material groups dispatched in the last frame (`SiConfig::reorderForBatching`).
+} SiFrameStats;
+
 /**
  * Configure the callback hub with user-defined or default implementations. This function should be called
  * before `siInitialize` to ensure that the SimUI library uses the correct callbacks.
@@ -58,11 +149,129 @@ void siRender();
  */
 void siShutdown();
 
+/**
+ * Retrieve the statistics of the last frame rendered with `siRender`, along with the high-water marks of all frames
+ * since `siInitialize`.
+ */
+SiFrameStats siGetFrameStats();
+
+/**
+ * Force the next `siRender` to draw even if its drawing events are the same as the previous frame's. Only needed with
+ * `SiConfig::skipUnchangedFrames`, after changing something the events only reference, like the pixels of a texture.
+ */
+void siMarkFrameDirty();
+
+/**
+ * Take the graphics context from the render thread (`SiConfig::useRenderThread`) so that the calling thread can create,
+ * update or destroy GPU resources, waiting for the frame being rendered first. Calls nest per thread and must be paired
+ * with `siReleaseRenderContext` on the same thread, other threads wait until the context is released. The loading
+ * functions of SimUI (fonts, textures, draw lists) already do this, the call is only needed around the user's own
+ * graphics calls. Does nothing without the render thread.
+ */
+void siAcquireRenderContext();
+
+/**
+ * Give the graphics context taken by `siAcquireRenderContext` back to the render thread.
+ */
+void siReleaseRenderContext();
+
 // =========================== Drawing API (but used internally) ===========================
 void siDrawRectangle(f32 x, f32 y, f32 width, f32 height, SiColor color, SiTexture texture);
 void siDrawRectangleSprite(f32 x, f32 y, f32 width, f32 height, SiColor color, SiSprite sprite);
+
+/**
+ * Draw an untextured rectangle with rounded corners and/or only its outline. With `borderWidth` set to `0` the whole
+ * rectangle is filled. Corner rounding is rendered by the instanced pipeline (`SIMUI_USE_INSTANCED_PIPELINE`) and the
+ * software renderer (`SIMUI_USE_SOFTWARE_RENDERER`), the default vertex pipeline draws square corners.
+ */
+void siDrawRoundedRectangle(f32 x, f32 y, f32 width, f32 height, SiColor color, f32 cornerRadius, f32 borderWidth);
 void siDrawText(f32 x, f32 y, const char* text, SiColor color, SiFont* pFont);
 
+// =========================== Thread Recording ===========================
+#define SI_MAX_THREAD_RECORDINGS 64
+
+/**
+ * Record the drawing calls of the calling thread into a command buffer of its own, so several threads can build parts
+ * of the frame in parallel without synchronizing per call. The recording is merged into the frame by the first
+ * `siRender` after `siEndThreadRecording`, after the drawing calls made outside of thread recordings. Recordings are
+ * merged by ascending `sortKey`; equal keys keep the order of their `siEndThreadRecording` calls, so distinct keys give
+ * the same frame whatever the thread timing.
+ *
+ * Draw lists can not be recorded inside a thread recording, and the fonts and draw lists used must stay alive until
+ * the frame is rendered.
+ *
+ * @example usage
+ *
+ * ```c
+ * // On every worker thread, before the frame is rendered.
+ * siBeginThreadRecording(panelIndex);
+ * siDrawRectangle(...);
+ * siDrawText(...);
+ * siEndThreadRecording();
+ *
+ * // On the rendering thread, once the workers are done.
+ * siRender();
+ * ```
+ */
+void siBeginThreadRecording(u32 sortKey);
+
+/**
+ * Finish the recording of the calling thread and submit it to the next `siRender`.
+ */
+void siEndThreadRecording();
+
+// =========================== Draw Lists ===========================
+/**
+ * Create an empty draw list. A draw list records primitives once into GPU-resident geometry which is replayed every
+ * frame with `siDrawList`, for UI parts that do not change between frames (grid lines, axis labels, panel frames).
+ *
+ * @example usage
+ *
+ * ```c
+ * if (!siIsDrawListValid(chrome))
+ * {
+ *     siBeginDrawList(chrome);
+ *     siDrawRectangle(...);
+ *     siDrawText(...);
+ *     siEndDrawList();
+ * }
+ *
+ * siDrawList(chrome, 0.0f, 0.0f);
+ * ```
+ */
+SiDrawList siCreateDrawList();
+
+/**
+ * Start recording `drawList`, replacing its previous content. Until `siEndDrawList`, the drawing functions record
+ * into the list instead of the frame. Recording must happen outside of `siRender`.
+ */
+void siBeginDrawList(SiDrawList drawList);
+
+/**
+ * Finish the recording started by `siBeginDrawList` and build the geometry of the list.
+ */
+void siEndDrawList();
+
+/**
+ * Replay `drawList` at its position in the frame, with every primitive moved by `offsetX` and `offsetY`. Replaying
+ * keeps the glyphs of the list in the glyph atlas, primitives sampling a texture destroyed since the recording are
+ * left out.
+ */
+void siDrawList(SiDrawList drawList, f32 offsetX, f32 offsetY);
+
+/**
+ * Mark `drawList` as needing to be recorded again, its content is still drawn until it is.
+ */
+void siInvalidateDrawList(SiDrawList drawList);
+
+/**
+ * Check whether `drawList` holds up-to-date geometry. A list is invalid until it is recorded, after
+ * `siInvalidateDrawList`, and when glyphs it draws were evicted from the glyph atlas since it was recorded.
+ */
+b8 siIsDrawListValid(SiDrawList drawList);
+
+void siDestroyDrawList(SiDrawList drawList);
+
 #ifdef SIMUI_USE_STB
 // =========================== Utils ===========================
 SiTexture readImageFile(const char* filePath);
@@ -0,0 +1,63 @@
+#pragma once
+#include "common.h"
+
+#if __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A block of memory owned by an arena. Chunks are kept in a singly linked list and reused after every reset.
+ */
+typedef struct SiArenaChunk
+{
+	struct SiArenaChunk* pNext; ///< The next chunk of the arena, `SI_NULL` for the last one.
+	u64					 size;	///< Number of usable bytes following the chunk header.
+	u64					 used;	///< Number of bytes handed out from this chunk since the last reset.
+} SiArenaChunk;
+
+/**
+ * Linear allocator made of chunks, used for memory that only lives until the end of the frame. Allocating is a pointer
+ * bump, a new chunk is only requested from the system when all chunks are exhausted, and `siArenaReset` releases
+ * everything in O(1) while keeping the chunks for the next frame.
+ */
+typedef struct SiArena
+{
+	SiArenaChunk* pFirstChunk;	 ///< The first chunk of the arena.
+	SiArenaChunk* pCurrentChunk; ///< The chunk allocations are currently served from.
+	u64			  chunkSize;	 ///< The size of the chunks requested when the arena grows.
+
+	u64 usedBytes;		///< Bytes handed out since the last reset, including alignment padding.
+	u64 highWaterBytes; ///< The largest `usedBytes` reached before a reset.
+	u64 reservedBytes;	///< Total number of bytes of all chunks owned by the arena.
+} SiArena;
+
+/**
+ * Prepare the arena and reserve its first chunk of `chunkSize` bytes. Later chunks have the same size, unless a single
+ * allocation is larger.
+ */
+void siArenaInitialize(SiArena* pArena, u64 chunkSize);
+
+/**
+ * Allocate `size` bytes aligned to `alignment` (a power of two) from the arena. The memory is not cleared and stays
+ * valid until the next `siArenaReset`.
+ */
+void* siArenaAllocate(SiArena* pArena, u64 size, u64 alignment);
+
+/**
+ * Copy the null-terminated string `string` into the arena and return the copy.
+ */
+char* siArenaCopyString(SiArena* pArena, const char* string);
+
+/**
+ * Release every allocation of the arena at once. The chunks are kept for reuse.
+ */
+void siArenaReset(SiArena* pArena);
+
+/**
+ * Free all chunks owned by the arena.
+ */
+void siArenaShutdown(SiArena* pArena);
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+#include "common.h"
+#include "texture.h"
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#define SI_ATLAS_PAGE_SIZE		1024 ///< Width and height in pixels of the image atlas pages.
+#define SI_ATLAS_MAX_PAGES		8	 ///< Number of pages after which images get a texture of their own.
+#define SI_ATLAS_MAX_IMAGE_SIZE 256	 ///< Images wider or taller than this get a texture of their own.
+
+/**
+ * Pack a small image, such as an icon, into a shared RGBA8 atlas page and return the sprite covering it. Drawing many
+ * atlas images with `siDrawRectangleSprite` samples a single texture, so they are batched together instead of breaking
+ * the batch once per image. RGB8 images are made opaque and R8 images become white with the channel as alpha.
+ *
+ * Images larger than `SI_ATLAS_MAX_IMAGE_SIZE`, or which do not fit into `SI_ATLAS_MAX_PAGES` pages, get a texture
+ * of their own, the returned sprite covers it entirely. The atlas space is only reclaimed by `siAtlasClear`.
+ *
+ * @param pData The tightly packed pixels of the image, in `format`.
+ */
+SiSprite siAtlasAddImage(u32 width, u32 height, SiTextureFormat format, const void* pData);
+
+#ifdef SIMUI_USE_STB
+/**
+ * Load an image file and pack it with `siAtlasAddImage`, the atlas counterpart of `readImageFile`.
+ */
+SiSprite siAtlasLoadImage(const char* filePath);
+#endif // SIMUI_USE_STB
+
+/**
+ * Destroy the atlas pages and the textures created by `siAtlasAddImage`, every sprite it returned becomes invalid.
+ * Called by `siShutdown`.
+ */
+void siAtlasClear();
+
+#if __cplusplus
+}
+#endif
\ No newline at end of file
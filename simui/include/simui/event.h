@@ -18,20 +18,32 @@ typedef enum SiUIEventType
 {
 	SI_UI_EVENT_TYPE_DRAW_RECTANGLE, ///< Draw rectangle event with the receive `DrawRectangleParameter`.
 	SI_UI_EVENT_TYPE_DRAW_TEXT,		 ///< Draw text event with the receive `DrawTextParameter`.
+	SI_UI_EVENT_TYPE_DRAW_LIST,		 ///< Replay a recorded draw list with the receive `DrawListParameter`.
 } SiUIEventType;
 
+#define SI_DRAW_LIST_NULL ((u32) - 1)
+#define SI_MAX_DRAW_LISTS 64
+
+/**
+ * Handle of a retained draw list, created with `siCreateDrawList`. The handle is an index lower than
+ * `SI_MAX_DRAW_LISTS`, so rendering backends can keep their own per-list data in a fixed array.
+ */
+typedef u32 SiDrawList;
+
 /**
  * The parameter structure for the rectangle drawing event.
  * It contains all necessary information required to draw a rectangle on the screen.
  */
 typedef struct DrawRectangleParameter
 {
-	f32		 x;		 ///< The x position of the rectangle.
-	f32		 y;		 ///< The y position of the rectangle.
-	f32		 width;	 ///< The width of the rectangle.
-	f32		 height; ///< The height of the rectangle.
-	SiColor	 color;	 ///< The color of the rectangle.
-	SiSprite sprite; ///< The texture to be used for the rectangle.
+	f32		 x;			   ///< The x position of the rectangle.
+	f32		 y;			   ///< The y position of the rectangle.
+	f32		 width;		   ///< The width of the rectangle.
+	f32		 height;	   ///< The height of the rectangle.
+	SiColor	 color;		   ///< The color of the rectangle.
+	SiSprite sprite;	   ///< The texture to be used for the rectangle.
+	f32		 cornerRadius; ///< The radius of the rounded corners, `0` for square corners.
+	f32		 borderWidth;  ///< The width of the outline, `0` to fill the whole rectangle.
 } DrawRectangleParameter;
 
 /**
@@ -47,6 +59,16 @@ typedef struct DrwawTextParameter
 	SiFont*		pFont; ///< The font to be used for rendering the text.
 } DrawTextParameter;
 
+/**
+ * The parameter structure for the draw list replay event.
+ */
+typedef struct DrawListParameter
+{
+	SiDrawList drawList; ///< The draw list to be replayed.
+	f32		   offsetX;	 ///< Horizontal offset added to every primitive of the list.
+	f32		   offsetY;	 ///< Vertical offset added to every primitive of the list.
+} DrawListParameter;
+
 /**
  * The structure representing a UI event in the SimUI library.
  * It contains the type of the event and a union of parameters specific to each event type.
@@ -59,6 +81,7 @@ typedef struct SiUIEvent
 	union {
 		DrawRectangleParameter drawRectangleParams; ///< Parameters for the draw rectangle event.
 		DrawTextParameter	   drawTextParams;		///< Parameters for the draw text event.
+		DrawListParameter	   drawListParams;		///< Parameters for the draw list replay event.
 	};
 } SiUIEvent;
 
@@ -76,6 +99,29 @@ typedef void (*FPN_SiDrawRectangle)(DrawRectangleParameter params, void* pRender
  */
 typedef void (*FPN_SiDrawText)(DrawTextParameter params, void* pRenderingData);
 
+/**
+ * The template method for replaying a draw list inside the frame, at its position in the painter's order.
+ */
+typedef void (*FPN_SiDrawList)(DrawListParameter params, void* pRenderingData);
+
+/**
+ * The template method called before the recorded primitives of a draw list are dispatched through the
+ * `FPN_SiDrawRectangle` and `FPN_SiDrawText` callbacks. The backend should capture them into the list instead of the
+ * frame until the matching `FPN_SiEndDrawList`.
+ */
+typedef void (*FPN_SiBeginDrawList)(SiDrawList drawList);
+
+/**
+ * The template method called once every recorded primitive of a draw list has been dispatched. The backend should
+ * store the captured geometry so replaying the list does no per-primitive work.
+ */
+typedef void (*FPN_SiEndDrawList)(SiDrawList drawList);
+
+/**
+ * The template method for releasing the backend resources of a draw list.
+ */
+typedef void (*FPN_SiDestroyDrawList)(SiDrawList drawList);
+
 #if __cplusplus
 }
 #endif
\ No newline at end of file
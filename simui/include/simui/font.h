@@ -7,17 +7,164 @@ extern "C" {
 #include "common.h"
 #include "simui/texture.h"
 
+/**
+ * Layout information of a single glyph, rasterized into the glyph atlas the first time it is looked up.
+ */
+typedef struct SiGlyph
+{
+	SiTexture texture; ///< The atlas page holding the glyph, `SI_TEXTURE_NULL` for glyphs without outline.
+	SiVector2 quadMin; ///< The minimum texture coordinates of the glyph inside the atlas page.
+	SiVector2 quadMax; ///< The maximum texture coordinates of the glyph inside the atlas page.
+	SiVector2 offset;  ///< Offset of the glyph's top-left corner from the pen position on the baseline (y down).
+	SiVector2 size;	   ///< Size of the glyph quad in pixels, `0` for glyphs without outline such as the space.
+	f32		  advance; ///< Horizontal distance in pixels from this pen position to the next one.
+} SiGlyph;
+
+/**
+ * How the glyphs of a font are rasterized into the glyph atlas.
+ */
+typedef enum SiFontRasterization
+{
+	SI_FONT_RASTERIZATION_BITMAP, ///< Coverage bitmaps rasterized at the font size, the sharpest at that exact size.
+	SI_FONT_RASTERIZATION_SDF,	  ///< Signed distance fields shared by every size of the face, crisp at any scale.
+} SiFontRasterization;
+
+/**
+ * A face loaded at a given pixel size. The struct is a lightweight handle into the font manager, which owns the font
+ * file and the glyphs. Every face and size shares the same glyph atlas pages, so mixing fonts inside a frame neither
+ * multiplies texture memory nor breaks text batches. Copies of a `SiFont` refer to the same font.
+ */
 typedef struct SiFont
 {
+	u32			id; ///< The handle of the font inside the font manager.
 	const char* file;
 	u32			size;
 	f32			sizeInPixels;
+
+	SiFontRasterization rasterization; ///< How the glyphs of the font are rasterized.
+
+	f32 ascent;	 ///< Distance in pixels from the baseline to the top of the highest glyph.
+	f32 descent; ///< Distance in pixels from the baseline to the bottom of the lowest glyph (negative).
+	f32 lineGap; ///< Additional spacing in pixels between two lines.
 } SiFont;
 
-void siFontLoad(const char* file, SiFont* pFont, f32 size);
+/**
+ * Load a font file at `size` pixels. Loading another size of an already loaded file shares the file data. No glyph is
+ * rasterized here, each codepoint is rasterized into the glyph atlas the first time it is looked up, so the cost
+ * scales with the glyphs actually drawn rather than with the charset of the font.
+ *
+ * With `SI_FONT_RASTERIZATION_SDF`, every size of the face shares a single set of distance field glyphs, so loading
+ * another size (or zooming by loading one) costs no rasterization and no atlas space.
+ */
+void siFontLoad(const char* file, SiFont* pFont, f32 size, SiFontRasterization rasterization);
+
+/**
+ * Keep the glyphs rasterized for a font size in `directory`, one `.simglyph` file per font file, size and
+ * rasterization, so later runs upload them from the mapped file instead of rasterizing them again. The glyphs drawn
+ * during a run are added to the file when the font is unloaded. Files are keyed by the path, size and modification
+ * time of the font file like the texture cache, editing a font file starts a new cache.
+ *
+ * The directory must exist, `SI_NULL` disables the cache. Called by `siInitialize` with `SiConfig::fontCacheDirectory`.
+ */
+void siSetFontCacheDirectory(const char* directory);
+
+SiSprite siGetFontSprite(SiFont* pFont, u32 codepoint);
+
+/**
+ * Compute a box containing every glyph of `text` drawn at `x`, `y` with `siDrawText`, from the glyph metrics only so
+ * nothing is rasterized. The box is conservative: it may be larger than the drawn glyphs, never smaller.
+ *
+ * @return The box as `x` = left, `y` = bottom, `z` = right and `w` = top, in drawing coordinates (y up).
+ */
+SiVector4 siGetTextBounds(SiFont* pFont, f32 x, f32 y, const char* text);
+
+/**
+ * Function pointer type called by `siLayoutText` for every glyph with an outline. `center` is the center of the glyph
+ * quad in drawing coordinates (y up), the quad is `pGlyph->size` large.
+ */
+typedef void (*FPN_SiLayoutGlyph)(const SiGlyph* pGlyph, SiVector2 center, void* pUserData);
+
+/**
+ * Place the glyphs of `text` drawn at `x`, `y` by `siDrawText`: `y` is the bottom of the line, the baseline sits
+ * `descent` above it, and the pen moves by the advance and the kerning of every glyph. Glyphs missing from the atlas
+ * are skipped. Backends call it from their `FPN_SiDrawText` to emit one quad per glyph with `glyphFunction`.
+ */
+void siLayoutText(SiFont* pFont, f32 x, f32 y, const char* text, FPN_SiLayoutGlyph glyphFunction, void* pUserData);
+
+/**
+ * Look up the glyph of `codepoint`, rasterizing it into the glyph atlas on a cache miss. When the atlas pages are
+ * full, the least recently used shelf of glyphs not drawn during the current frame is evicted.
+ *
+ * @return The glyph, valid until the next call, or `SI_NULL` when no atlas space could be reclaimed for it.
+ */
+const SiGlyph* siGetFontGlyph(SiFont* pFont, u32 codepoint);
+
+/**
+ * Look up the kerning adjustment in pixels to add to the pen position between `left` and `right`.
+ */
+f32 siGetFontKerning(SiFont* pFont, u32 left, u32 right);
+
+/**
+ * Upload the atlas regions rasterized since the last call and start a new eviction frame. Called by `siRender`
+ * once every drawing event has been dispatched and before the frame ends.
+ */
+void siFlushFontAtlas();
+
+/**
+ * Get the generation of the glyph atlas, increased every time cached glyphs are removed from it. Geometry retained
+ * across frames that references glyph texture coordinates must be rebuilt when the generation changes.
+ */
+u32 siGetFontAtlasGeneration();
+
+/**
+ * A shelf of the glyph atlas as seen by geometry retained across frames. Shelves are the unit of eviction, so the
+ * glyphs of retained geometry stay valid as long as none of their shelves changed generation.
+ */
+typedef struct SiGlyphShelf
+{
+	u16 page;		///< The atlas page holding the shelf.
+	u16 shelf;		///< The index of the shelf inside the page.
+	u32 generation; ///< The generation of the shelf when it was captured, see `siAreGlyphShelvesValid`.
+} SiGlyphShelf;
+
+/**
+ * A set of distinct glyph shelves filled by `siCaptureGlyphShelves`, its array is owned by the caller.
+ */
+typedef struct SiGlyphShelfSet
+{
+	SiGlyphShelf* pShelves; ///< The captured shelves, `free` it once the set is not needed anymore.
+	u32			  count;	///< Number of shelves of the set.
+	u32			  capacity; ///< Number of shelves `pShelves` can hold.
+} SiGlyphShelfSet;
+
+/**
+ * Empty `pSet` and add to it the shelf of every glyph looked up until the next call, which stops the capture when
+ * `pSet` is `SI_NULL`. Used to learn which shelves a draw list depends on while it is recorded.
+ */
+void siCaptureGlyphShelves(SiGlyphShelfSet* pSet);
+
+/**
+ * Mark the shelves of `pSet` as used during the current eviction frame, like looking up their glyphs would. Retained
+ * geometry calls it every time it is drawn, so the glyphs it samples are not evicted as least recently used.
+ */
+void siTouchGlyphShelves(const SiGlyphShelfSet* pSet);
+
+/**
+ * @return Whether no shelf of `pSet` was evicted or cleared since it was captured.
+ */
+b8 siAreGlyphShelvesValid(const SiGlyphShelfSet* pSet);
 
-SiSprite siGetFontSprite(SiFont* pFont, i8 character);
+/**
+ * Decode the UTF-8 sequence at `*ppText` and advance the pointer past it. Malformed sequences decode to U+FFFD.
+ *
+ * @return The decoded codepoint, or `0` at the end of the string (the pointer is not advanced).
+ */
+u32 siDecodeUtf8(const char** ppText);
 
+/**
+ * Release a font loaded by `siFontLoad`. The file data is freed with the last size using it, and the atlas pages with
+ * the last loaded font.
+ */
 void siFontUnload(SiFont* pFont);
 
 #if __cplusplus
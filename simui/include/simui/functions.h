@@ -34,6 +34,27 @@ typedef void (*FPN_SiBeginFrame)();
  */
 typedef void (*FPN_SiEndFrame)();
 
+/**
+ * Function pointer type called by `siRender` instead of `FPN_SiBeginFrame` and `FPN_SiEndFrame` when the frame is
+ * identical to the previous one (see `SiConfig::skipUnchangedFrames`). The backend should keep presenting the last
+ * rendered image, and may throttle the application loop since nothing is drawn.
+ */
+typedef void (*FPN_SiSkipFrame)();
+
+/**
+ * Function pointer type called by `siRender` before `FPN_SiBeginFrame` when `SiConfig::redrawDirtyRegions` is set.
+ * Only the pixels inside `region` (left, bottom, right and top in drawing coordinates) changed since the last frame,
+ * the backend should keep every pixel outside of it and limit the drawing to it. Only the events overlapping the region
+ * are dispatched. A region spanning `-FLT_MAX` to `FLT_MAX` asks for a redraw of the whole frame.
+ */
+typedef void (*FPN_SiSetDirtyRegion)(SiVector4 region);
+
+/**
+ * Function pointer type making the graphics context current (`isCurrent` set) or not current on the calling thread.
+ * Needed for `SiConfig::useRenderThread`, which moves the context between the application and the render thread.
+ */
+typedef void (*FPN_SiMakeContextCurrent)(b8 isCurrent);
+
 /**
  * Function pointer type for the simulation shutdown function. If user wants to
  * override the default shutdown, they can provide a function matching this signature. Be called
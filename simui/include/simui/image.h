@@ -0,0 +1,72 @@
+#pragma once
+#include "common.h"
+#include "texture.h"
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#ifdef SIMUI_USE_STB
+#define SI_MAX_ASYNC_IMAGES		1024 ///< Number of images which can be loading or loaded through `siLoadImageAsync`.
+#define SI_IMAGE_LOADER_THREADS 4	 ///< Number of worker threads decoding the images.
+
+/**
+ * Handle of an image loaded with `siLoadImageAsync`. The handle is an index lower than `SI_MAX_ASYNC_IMAGES`.
+ */
+typedef u32 SiImage;
+
+typedef enum SiImageStatus
+{
+	SI_IMAGE_STATUS_LOADING, ///< Waiting for a worker, being decoded or waiting for its upload.
+	SI_IMAGE_STATUS_READY,	 ///< Uploaded, `siGetImageSprite` returns its texture.
+	SI_IMAGE_STATUS_FAILED,	 ///< The file could not be read or decoded.
+} SiImageStatus;
+
+/**
+ * Start loading an image file without blocking. The file is decoded as RGBA8 by a pool of `SI_IMAGE_LOADER_THREADS`
+ * workers, started by the first call, and the decoded pixels are uploaded by `siRender` within
+ * `SiConfig::imageUploadBudgetSeconds` per frame. Until the image is ready, `siGetImageSprite` returns a placeholder
+ * sprite without texture, which draws a plain rectangle of the draw color.
+ *
+ * @example usage
+ *
+ * ```c
+ * SiImage thumbnail = siLoadImageAsync("thumbnails/0042.png");
+ *
+ * // Every frame, the same call draws the placeholder and then the image.
+ * siDrawRectangleSprite(x, y, 128.0f, 128.0f, SI_COLOR_WHITE, siGetImageSprite(thumbnail));
+ *
+ * // When the thumbnail scrolls out of view, whether it finished loading or not.
+ * siCancelImage(thumbnail);
+ * ```
+ */
+SiImage siLoadImageAsync(const char* filePath);
+
+SiImageStatus siGetImageStatus(SiImage image);
+
+/**
+ * The sprite covering the whole image once it is ready, or else a sprite with `SI_TEXTURE_NULL`.
+ */
+SiSprite siGetImageSprite(SiImage image);
+
+/**
+ * Release the image: a load still waiting or decoding is abandoned, and the texture of a ready image is destroyed. The
+ * handle must not be used afterwards.
+ */
+void siCancelImage(SiImage image);
+
+/**
+ * Upload the decoded images into textures, until `budgetSeconds` have passed. At least one image is uploaded per call
+ * so the loads always progress. Called by `siRender` on the thread owning the graphics context.
+ */
+void siUploadLoadedImages(f64 budgetSeconds);
+
+/**
+ * Stop the workers and release every image. Called by `siShutdown`.
+ */
+void siShutdownImageLoader();
+#endif // SIMUI_USE_STB
+
+#if __cplusplus
+}
+#endif
\ No newline at end of file
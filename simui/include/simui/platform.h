@@ -26,7 +26,8 @@ void siPrintWarning(const char* message, ...);
 #define _SI_STRINGIFY(x) #x
 
 /**
- * Read the contents of a file into a buffer.
+ * Read the contents of a file into a buffer, followed by a null terminator. Files which do not fit into the buffer are
+ * an error, `siMapFile` reads files of any size without copying them.
  *
  * @param filePath The path to the file to be read.
  * @param buffer The buffer to store the file contents.
@@ -35,6 +36,42 @@ void siPrintWarning(const char* message, ...);
  */
 u32 readFile(const char* filePath, char* buffer, u32 bufferSize);
 
+/**
+ * Read-only view of a whole file mapped into memory with `siMapFile`.
+ */
+typedef struct SiMappedFile
+{
+	const u8* pData;   ///< The first byte of the file.
+	u64		  size;	   ///< The size of the file in bytes.
+	void*	  pHandle; ///< Backend specific handle of the mapping, the Win32 file mapping object.
+} SiMappedFile;
+
+/**
+ * Map the file at `filePath` into memory, its pages are read by the system when first accessed instead of being copied
+ * into a buffer. Empty and missing files can not be mapped.
+ *
+ * @return `SI_TRUE` if `pFile` holds the mapping, to be released with `siUnmapFile`.
+ */
+b8	 siMapFile(const char* filePath, SiMappedFile* pFile);
+void siUnmapFile(SiMappedFile* pFile);
+
+/**
+ * Retrieve the size in bytes and the last modification time of the file at `filePath`. The time is only meaningful
+ * for comparisons with other values returned by this function.
+ *
+ * @return `SI_FALSE` if the file does not exist.
+ */
+b8 siGetFileInfo(const char* filePath, u64* pSize, u64* pModifiedTime);
+
+/**
+ * Write `pHeader` followed by `pData` to the file at `filePath`, replacing it. The bytes go to a temporary file next to
+ * it which is renamed over `filePath` once complete, so readers never see a partial file and existing mappings of the
+ * previous file (`siMapFile`) keep their content.
+ *
+ * @return `SI_FALSE` if the file could not be written, `filePath` is left untouched then.
+ */
+b8 siWriteFileAtomic(const char* filePath, const void* pHeader, u64 headerSize, const void* pData, u64 dataSize);
+
 /**
  * Used for working with font files, to determine the endianness of the system.
  */
@@ -44,6 +81,62 @@ u64 siU64LittleToBigEndian(u64 value);
 u32 siU32LittleToBigEndian(u32 value);
 u16 siU16LittleToBigEndian(u16 value);
 
+// =========================== Threading ===========================
+#ifdef _MSC_VER
+#define SI_THREAD_LOCAL __declspec(thread)
+#else
+#define SI_THREAD_LOCAL _Thread_local
+#endif
+
+/**
+ * Opaque mutual exclusion lock, backed by `pthread_mutex_t` or a Win32 `SRWLOCK`.
+ */
+typedef struct SiMutex SiMutex;
+
+SiMutex* siCreateMutex();
+void	 siLockMutex(SiMutex* pMutex);
+void	 siUnlockMutex(SiMutex* pMutex);
+void	 siDestroyMutex(SiMutex* pMutex);
+
+/**
+ * Opaque condition variable, backed by `pthread_cond_t` or a Win32 `CONDITION_VARIABLE`.
+ */
+typedef struct SiCondition SiCondition;
+
+SiCondition* siCreateCondition();
+
+/**
+ * Atomically unlock `pMutex` and wait until the condition is signaled, `pMutex` is locked again on return. Wake-ups
+ * may be spurious, so the waited state must be checked in a loop.
+ */
+void siWaitCondition(SiCondition* pCondition, SiMutex* pMutex);
+void siBroadcastCondition(SiCondition* pCondition);
+void siDestroyCondition(SiCondition* pCondition);
+
+/**
+ * Opaque thread handle, backed by `pthread_t` or a Win32 thread handle.
+ */
+typedef struct SiThread SiThread;
+
+typedef void (*FPN_SiThreadFunction)(void* pArgument);
+
+SiThread* siCreateThread(FPN_SiThreadFunction function, void* pArgument);
+
+/**
+ * Wait for the thread to return from its function and release the handle.
+ */
+void siJoinThread(SiThread* pThread);
+
+/**
+ * Suspend the calling thread for at least `seconds`.
+ */
+void siSleep(f64 seconds);
+
+/**
+ * Seconds elapsed on a monotonic clock since an unspecified starting point, only meaningful as a difference.
+ */
+f64 siGetTime();
+
 #if __cplusplus
 }
 #endif
\ No newline at end of file
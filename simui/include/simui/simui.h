@@ -4,13 +4,19 @@
 extern "C" {
 #endif
 
+#include "arena.h"
+#include "atlas.h"
 #include "common.h"
 #include "datatypes.h"
 #include "event.h"
 #include "font.h"
 #include "functions.h"
+#include "image.h"
 #include "platform.h"
+#include "software_renderer.h"
 #include "texture.h"
+#include "texture_cache.h"
+#include "texture_pool.h"
 
 // =========================== Context ===========================
 /**
@@ -24,6 +30,11 @@ typedef struct SiCallbackHub
 	FPN_SiPollEvents  pollEventsFunction;	 ///< Pointer to the user-defined poll events function.
 	FPN_SiBeginFrame  beginFrameFunction;	 ///< Pointer to the user-defined begin frame function.
 	FPN_SiEndFrame	  endFrameFunction;		 ///< Pointer to the user-defined end frame function.
+	FPN_SiSkipFrame	  skipFrameFunction;	 ///< Pointer to the user-defined skip frame function.
+
+	FPN_SiSetDirtyRegion	 setDirtyRegionFunction;	 ///< Pointer to the user-defined set dirty region function.
+	FPN_SiMakeContextCurrent makeContextCurrentFunction; ///< Pointer to the user-defined make context current function.
+
 	FPN_SiShutdown	  shutdownFunction;		 ///< Pointer to the user-defined shutdown function.
 	FPN_GetWindowSize getWindowSizeFunction; ///< Pointer to the user-defined get window size function.
 
@@ -33,6 +44,14 @@ typedef struct SiCallbackHub
 	FPN_SiDrawRectangle drawRectangleFunction;
 
 	FPN_SiDrawText drawTextFunction;
+
+	/**
+	 * Pointers to the user-defined draw list functions. If not provided, draw lists are recorded but never drawn.
+	 */
+	FPN_SiDrawList		  drawListFunction;
+	FPN_SiBeginDrawList	  beginDrawListFunction;
+	FPN_SiEndDrawList	  endDrawListFunction;
+	FPN_SiDestroyDrawList destroyDrawListFunction;
 } SiCallbackHub;
 
 typedef struct SiContext
@@ -49,6 +68,13 @@ typedef struct SiContext
 	b8 isBigEndian; ///< Flag indicating the endianness of the system.
 
 	SiFont defaultFont; ///< The default font used in SimUI.
+
+	SiArena frameArena; ///< Per-frame memory holding the drawing events and their text, reset after `siRender`.
+
+	b8		  useRenderThread;	///< Whether frames are rendered by a dedicated thread, see `SiConfig::useRenderThread`.
+	SiVector2 renderWindowSize; ///< The window size of the frame being rendered, to be used by `FPN_SiBeginFrame`.
+
+	const char* shaderCacheDirectory; ///< See `SiConfig::shaderCacheDirectory`, used by the backend.
 } SiContext;
 
 // =========================== Main API Functions ===========================
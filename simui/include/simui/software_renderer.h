@@ -0,0 +1,65 @@
+#pragma once
+#include "common.h"
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#ifdef SIMUI_USE_SOFTWARE_RENDERER
+#define SI_SOFTWARE_FRAMEBUFFER_WIDTH  800 ///< Width in pixels of the framebuffer created by `siInitialize`.
+#define SI_SOFTWARE_FRAMEBUFFER_HEIGHT 600 ///< Height in pixels of the framebuffer created by `siInitialize`.
+#define SI_SOFTWARE_RENDERER_THREADS   4   ///< Threads rasterizing a frame, the one calling `siRender` included.
+
+/**
+ * The software renderer (`SIMUI_USE_SOFTWARE_RENDERER`) draws the frames into a framebuffer in memory instead of a
+ * window, for headless machines without a GPU and for pixel-exact reference images. The framebuffer is split into bands
+ * of rows rasterized in parallel, every pixel is written by a single thread in the painter's order so the image does
+ * not depend on the thread count nor on the instruction set used for blending.
+ *
+ * There is no window to close, the application decides when to leave its loop.
+ *
+ * @example usage
+ *
+ * ```c
+ * siConfigureCallbacks();
+ * siInitialize(config);
+ * siResizeSoftwareFramebuffer(1280, 720);
+ *
+ * siDrawRectangle(...);
+ * siRender();
+ * siWriteSoftwareFramebufferPng("snapshot.png");
+ *
+ * siShutdown();
+ * ```
+ */
+void siResizeSoftwareFramebuffer(u32 width, u32 height);
+
+/**
+ * Retrieve the RGBA8 pixels of the last rendered frame, tightly packed with the top row first. The alpha channel is
+ * blended like the color channels, as by the default renderer, so translucent primitives leave it below 255. With
+ * `SiConfig::useRenderThread`, the pixels must be read between `siAcquireRenderContext` and `siReleaseRenderContext`.
+ *
+ * @return The pixels, valid until the next `siRender` or `siResizeSoftwareFramebuffer`.
+ */
+const u8* siGetSoftwareFramebuffer(u32* pWidth, u32* pHeight);
+
+/**
+ * Write the pixels returned by `siGetSoftwareFramebuffer` to `filePath` as they are, without any header.
+ *
+ * @return `SI_FALSE` if the file could not be written.
+ */
+b8 siWriteSoftwareFramebufferRaw(const char* filePath);
+
+#ifdef SIMUI_USE_STB
+/**
+ * Write the last rendered frame to `filePath` as a PNG image.
+ *
+ * @return `SI_FALSE` if the file could not be written.
+ */
+b8 siWriteSoftwareFramebufferPng(const char* filePath);
+#endif // SIMUI_USE_STB
+#endif // SIMUI_USE_SOFTWARE_RENDERER
+
+#if __cplusplus
+}
+#endif
@@ -7,8 +7,24 @@ extern "C" {
 #endif
 
 #define SI_TEXTURE_NULL ((u32) - 1)
+
+#define SI_TEXTURE_INDEX_BITS		   20
+#define SI_TEXTURE_INDEX_MASK		   ((1u << SI_TEXTURE_INDEX_BITS) - 1u)
+#define SI_TEXTURE_GENERATION_MASK	   ((1u << (32 - SI_TEXTURE_INDEX_BITS)) - 1u)
+#define SI_TEXTURE_INDEX(texture)	   ((texture) & SI_TEXTURE_INDEX_MASK)
+#define SI_TEXTURE_GENERATION(texture) ((texture) >> SI_TEXTURE_INDEX_BITS)
+
+/**
+ * Handle of a texture, made of a slot index (low `SI_TEXTURE_INDEX_BITS` bits) and the generation of the slot (high
+ * bits). Destroying a texture bumps the generation of its slot, so a stale handle is told apart from the texture which
+ * reuses the slot later.
+ */
 typedef u32 SiTexture;
 
+/**
+ * A region of a texture. Coordinates outside of [0, 1] repeat the texture, except with the instanced pipeline
+ * (`SIMUI_USE_INSTANCED_PIPELINE`) which clamps them to [0, 1].
+ */
 typedef struct SiSprite
 {
 	SiTexture texture; ///< The texture associated with the sprite.
@@ -37,6 +53,42 @@ typedef enum SiTextureFormat
  */
 SiTexture siCreateTexture(u32 width, u32 height, SiTextureFormat format, const void* pData);
 
+/**
+ * Rendering specific function for updating a region of a texture. User must provide their own implementation
+ * matching this signature if they want to draw text, the glyph atlas uploads newly rasterized glyphs through it.
+ *
+ * @param texture The texture to be updated.
+ * @param x       The left column of the region.
+ * @param y       The top row of the region.
+ * @param width   The width of the region.
+ * @param height  The height of the region.
+ * @param pData   The tightly packed pixels of the region, in the format the texture was created with.
+ */
+void siUpdateTexture(SiTexture texture, u32 x, u32 y, u32 width, u32 height, const void* pData);
+
+/**
+ * Rendering specific function for writing a region of a texture in place, without the copy `siUpdateTexture` makes of
+ * its pixels. The returned memory is write-only staging memory of `width * height` tightly packed pixels in the format
+ * the texture was created with; it is uploaded by `siUnmapTextureRegion`. Only one region can be mapped at a time and
+ * the calling thread holds the graphics context until it is unmapped (`siAcquireRenderContext`).
+ *
+ * @example usage
+ *
+ * ```c
+ * u8* pPixels = siMapTextureRegion(plot, 0, 0, width, height);
+ * drawPlotPixels(pPixels, width, height);
+ * siUnmapTextureRegion(plot);
+ * ```
+ *
+ * @return A pointer to the staging memory of the region.
+ */
+void* siMapTextureRegion(SiTexture texture, u32 x, u32 y, u32 width, u32 height);
+
+/**
+ * Upload the region mapped by `siMapTextureRegion` into `texture`, the pointer it returned becomes invalid.
+ */
+void siUnmapTextureRegion(SiTexture texture);
+
 /**
  * Rendering specific function for getting the size of a texture. User must provide their own implementation
  * matching this signature if they want to use textures in their UI. This function should return
@@ -0,0 +1,39 @@
+#pragma once
+#include "common.h"
+#include "texture.h"
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#define SI_TEXTURE_CACHE_EXTENSION ".simtex"
+#define SI_TEXTURE_CACHE_PATH_SIZE 512 ///< Maximum length of the cache directory and of the cache file paths.
+
+/**
+ * Store the decoded images loaded by `readImageFile` into `directory`, one `.simtex` file per image, and load them from
+ * there on later runs instead of decoding the image files again. A cache file holds the pixels in the format they are
+ * uploaded in and is mapped into memory, the texture is created straight from the mapping. Cache files are named after
+ * the hash of the image path and are rebuilt when the size or the modification time of the image changes.
+ *
+ * The directory must exist, `SI_NULL` disables the cache. Called by `siInitialize` with
+ * `SiConfig::textureCacheDirectory`.
+ */
+void siSetTextureCacheDirectory(const char* directory);
+
+/**
+ * Create a texture from the cache file of the image at `filePath`.
+ *
+ * @return The created texture, or `SI_TEXTURE_NULL` if the cache is disabled, or the cache file is missing or stale.
+ */
+SiTexture siLoadCachedTexture(const char* filePath);
+
+/**
+ * Write the decoded pixels of the image at `filePath` into its cache file, does nothing if the cache is disabled.
+ *
+ * @param pPixels The tightly packed pixels of the image, in `format`.
+ */
+void siStoreCachedTexture(const char* filePath, u32 width, u32 height, SiTextureFormat format, const void* pPixels);
+
+#if __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include "common.h"
+#include "texture.h"
+
+#if __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The part of a texture slot every backend shares. The slots live in fixed-size pages which never move once allocated,
+ * so a slot resolved on the render thread stays valid while another page is added.
+ */
+typedef struct SiTextureSlot
+{
+	u32				width;
+	u32				height;
+	SiTextureFormat format;
+
+	b8	isUsed;		///< Flag to indicate if the texture slot is used.
+	u32 generation; ///< Bumped when the texture of the slot is destroyed, see `SiTexture`.
+	u32 nextFree;	///< The next slot of the free list while the slot is unused.
+} SiTextureSlot;
+
+/**
+ * Reset the texture slots handed out by `siAllocateTextureSlot`. Next to every slot the pool keeps `dataSize` zeroed
+ * bytes for the backend, such as the name of the OpenGL texture, see `siGetTextureSlotData`. Backends built on the
+ * pool call it from their `FPN_SiInitialize`.
+ */
+void siInitializeTexturePool(u32 dataSize);
+
+/**
+ * Destroy every texture still alive with `siDestroyTexture` and free the slot pages. Backends built on the pool call
+ * it from their `FPN_SiShutdown`.
+ */
+void siShutdownTexturePool();
+
+/**
+ * Hand out an unused slot, the pool is not synchronized so the backends call it from `siCreateTexture` while holding
+ * the render context.
+ *
+ * @return The handle of the texture stored in the slot.
+ */
+SiTexture siAllocateTextureSlot(u32 width, u32 height, SiTextureFormat format);
+
+/**
+ * Give the slot of `texture` back to the pool and bump its generation, every handle to it becomes stale. Called from
+ * `siDestroyTexture` once the backend released its own objects. A slot whose generation reaches
+ * `SI_TEXTURE_GENERATION_MASK` is never handed out again.
+ */
+void siReleaseTextureSlot(SiTexture texture);
+
+/**
+ * Stop with an error when `texture` is not a handle of a live texture.
+ */
+void siValidateTexture(SiTexture texture);
+
+/**
+ * Whether `texture` still refers to a live texture, for handles kept across frames like the batches of a draw list.
+ */
+b8 siIsTextureAlive(SiTexture texture);
+
+/**
+ * Resolve the slot of `texture`, which must be valid (`siValidateTexture`).
+ */
+SiTextureSlot* siGetTextureSlot(SiTexture texture);
+
+/**
+ * Resolve the backend data of the slot of `texture`, the `dataSize` bytes given to `siInitializeTexturePool`.
+ */
+void* siGetTextureSlotData(SiTexture texture);
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+#version 330 core
+
+layout (location = 0) in vec4 iRect;   // center.xy, size.xy
+layout (location = 1) in vec4 iUvRect; // quadMin.xy, quadMax.xy
+layout (location = 2) in vec4 iColor;
+layout (location = 3) in vec2 iStyle;  // corner radius, border width
+
+uniform vec2 windowSize;
+uniform vec2 offset;
+
+out vec2 aTexCoord;
+out vec4 aColor;
+out vec2 aLocalPos;
+out vec2 aHalfSize;
+out vec2 aStyle;
+
+void main()
+{
+    // Corners follow the static quad index pattern: bottom-left, bottom-right, top-right, top-left.
+    vec2 corner = vec2((gl_VertexID == 1 || gl_VertexID == 2) ? 1.0 : 0.0, (gl_VertexID >= 2) ? 1.0 : 0.0);
+
+    vec2 halfSize = iRect.zw * 0.5;
+    vec2 localPos = (corner * 2.0 - 1.0) * halfSize;
+
+    vec2 pos = (iRect.xy + localPos + offset) / windowSize - 1;
+    gl_Position = vec4(pos, 0.0, 1.0);
+
+    aTexCoord = vec2(mix(iUvRect.x, iUvRect.z, corner.x), mix(iUvRect.w, iUvRect.y, corner.y));
+    aColor = iColor;
+    aLocalPos = localPos;
+    aHalfSize = halfSize;
+    aStyle = iStyle;
+}
@@ -0,0 +1,36 @@
+#version 330 core
+
+in vec4 aColor;
+in vec2 aLocalPos;
+in vec2 aHalfSize;
+in vec2 aStyle; // corner radius, border width
+
+out vec4 fragColor;
+
+// Signed distance from `p` to the border of a box centered at the origin with rounded corners of radius `r`.
+float roundedBoxDistance(vec2 p, vec2 halfSize, float r)
+{
+    vec2 q = abs(p) - halfSize + r;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;
+}
+
+void main()
+{
+    if (aStyle.x <= 0.0 && aStyle.y <= 0.0)
+    {
+        fragColor = aColor;
+        return;
+    }
+
+    float radius = min(aStyle.x, min(aHalfSize.x, aHalfSize.y));
+    float dist = roundedBoxDistance(aLocalPos, aHalfSize, radius);
+    float aa = max(fwidth(dist), 1e-4);
+
+    float coverage = clamp(0.5 - dist / aa, 0.0, 1.0);
+    if (aStyle.y > 0.0)
+    {
+        coverage *= clamp(0.5 + (dist + aStyle.y) / aa, 0.0, 1.0);
+    }
+
+    fragColor = vec4(aColor.rgb, aColor.a * coverage);
+}
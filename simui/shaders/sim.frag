@@ -1,10 +1,10 @@
 #version 330 core
 
-uniform vec4 uColor;
+in vec4 aColor;
 
 out vec4 color;
 
 void main()
 {
-    color = uColor;
+    color = aColor;
 };
@@ -1,15 +1,15 @@
 #version 330 core
 
-uniform vec4      uColor;
 uniform sampler2D uTexture;
 
 in vec2 aTexCoord;
+in vec4 aColor;
 
 out vec4 fragColor;
 
 void main()
 {
-    fragColor = vec4(1.0, 1.0, 1.0, texture(uTexture, aTexCoord).a) * uColor;
+    fragColor = vec4(1.0, 1.0, 1.0, texture(uTexture, aTexCoord).a) * aColor;
 };
 
 
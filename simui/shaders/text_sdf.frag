@@ -0,0 +1,19 @@
+#version 330 core
+
+uniform sampler2D uTexture;
+
+in vec2 aTexCoord;
+in vec4 aColor;
+
+out vec4 fragColor;
+
+// The outline sits at 0.5 in the distance field, the smoothing band follows the screen-space rate of change of the
+// distance so edges stay one pixel wide at any size.
+void main()
+{
+    float dist = texture(uTexture, aTexCoord).a;
+    float aa = max(fwidth(dist), 1e-4);
+    float coverage = smoothstep(0.5 - aa, 0.5 + aa, dist);
+
+    fragColor = vec4(aColor.rgb, aColor.a * coverage);
+}
@@ -1,14 +1,14 @@
 #version 330 core
 
-uniform vec4      uColor;
 uniform sampler2D uTexture;
 
 in vec2 aTexCoord;
+in vec4 aColor;
 
 out vec4 fragColor;
 
 void main()
 {
-    fragColor = texture(uTexture, aTexCoord) * uColor;
+    fragColor = texture(uTexture, aTexCoord) * aColor;
 };
 
@@ -2,14 +2,18 @@
 
 layout (location = 0) in vec2 vPos;
 layout (location = 1) in vec2 vTexCoord;
+layout (location = 2) in vec4 vColor;
 
 uniform vec2 windowSize;
+uniform vec2 offset;
 
 out vec2 aTexCoord;
+out vec4 aColor;
 
 void main()
 {
-    vec2 pos = vPos / windowSize - 1;
+    vec2 pos = (vPos + offset) / windowSize - 1;
     gl_Position = vec4(pos, 0.0, 1.0);
     aTexCoord = vTexCoord;
+    aColor = vColor;
 }
\ No newline at end of file
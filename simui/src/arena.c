@@ -0,0 +1,99 @@
+#include "simui/simui.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static SiArenaChunk* createChunk(u64 size)
+{
+	SiArenaChunk* pChunk = (SiArenaChunk*)malloc(sizeof(SiArenaChunk) + size);
+	if (pChunk == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate an arena chunk of %llu bytes.", (unsigned long long)size);
+	}
+
+	pChunk->pNext = SI_NULL;
+	pChunk->size  = size;
+	pChunk->used  = 0u;
+	return pChunk;
+}
+
+void siArenaInitialize(SiArena* pArena, u64 chunkSize)
+{
+	memset(pArena, 0, sizeof(SiArena));
+
+	pArena->chunkSize	  = chunkSize;
+	pArena->pFirstChunk	  = createChunk(chunkSize);
+	pArena->pCurrentChunk = pArena->pFirstChunk;
+	pArena->reservedBytes = chunkSize;
+}
+
+void* siArenaAllocate(SiArena* pArena, u64 size, u64 alignment)
+{
+	SiArenaChunk* pChunk = pArena->pCurrentChunk;
+
+	while (SI_TRUE)
+	{
+		u8* pBase	 = (u8*)(pChunk + 1);
+		u64 address	 = (u64)(uintptr_t)(pBase + pChunk->used);
+		u64 padding	 = (alignment - (address & (alignment - 1u))) & (alignment - 1u);
+		u64 required = padding + size;
+
+		if (pChunk->used + required <= pChunk->size)
+		{
+			void* pMemory = pBase + pChunk->used + padding;
+			pChunk->used += required;
+			pArena->usedBytes += required;
+			pArena->pCurrentChunk = pChunk;
+			return pMemory;
+		}
+
+		// Chunks after the current one are free since the last reset, they are recycled before allocating new ones.
+		SiArenaChunk* pNext = pChunk->pNext;
+		if (pNext != SI_NULL && pNext->size >= size + alignment)
+		{
+			pNext->used = 0u;
+			pChunk		= pNext;
+			continue;
+		}
+
+		u64			  newSize  = size + alignment > pArena->chunkSize ? size + alignment : pArena->chunkSize;
+		SiArenaChunk* pCreated = createChunk(newSize);
+		pCreated->pNext		   = pNext;
+		pChunk->pNext		   = pCreated;
+		pArena->reservedBytes += newSize;
+		pChunk = pCreated;
+	}
+}
+
+char* siArenaCopyString(SiArena* pArena, const char* string)
+{
+	u64	  length = strlen(string);
+	char* pCopy	 = (char*)siArenaAllocate(pArena, length + 1u, 1u);
+	memcpy(pCopy, string, length + 1u);
+	return pCopy;
+}
+
+void siArenaReset(SiArena* pArena)
+{
+	if (pArena->usedBytes > pArena->highWaterBytes)
+	{
+		pArena->highWaterBytes = pArena->usedBytes;
+	}
+
+	pArena->usedBytes		  = 0u;
+	pArena->pCurrentChunk	  = pArena->pFirstChunk;
+	pArena->pFirstChunk->used = 0u;
+}
+
+void siArenaShutdown(SiArena* pArena)
+{
+	SiArenaChunk* pChunk = pArena->pFirstChunk;
+	while (pChunk != SI_NULL)
+	{
+		SiArenaChunk* pNext = pChunk->pNext;
+		free(pChunk);
+		pChunk = pNext;
+	}
+
+	memset(pArena, 0, sizeof(SiArena));
+}
@@ -0,0 +1,234 @@
+#include "simui/atlas.h"
+#include "simui/simui.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SIMUI_USE_STB
+#include <stb_image.h>
+#endif // SIMUI_USE_STB
+
+#define ATLAS_PADDING			   1u
+#define ATLAS_SHELF_GRANULARITY	   8u
+#define ATLAS_MAX_SHELVES_PER_PAGE (SI_ATLAS_PAGE_SIZE / ATLAS_SHELF_GRANULARITY)
+
+#define INITIAL_STANDALONE_CAPACITY 16u
+
+/**
+ * A row of the page holding images of about the same height, filled from left to right.
+ */
+typedef struct AtlasShelf
+{
+	u16 y;		 ///< The top row of the shelf inside the page.
+	u16 height;	 ///< The height of the shelf, rounded up to `ATLAS_SHELF_GRANULARITY`.
+	u16 cursorX; ///< The first free column of the shelf.
+} AtlasShelf;
+
+/**
+ * A RGBA8 texture split into shelves, top to bottom.
+ */
+typedef struct AtlasPage
+{
+	SiTexture  texture;								///< The texture of the page.
+	AtlasShelf shelves[ATLAS_MAX_SHELVES_PER_PAGE]; ///< The shelves of the page, top to bottom.
+	u32		   shelfCount;							///< The number of used entries of `shelves`.
+	u32		   nextShelfY;							///< The first row not covered by a shelf yet.
+} AtlasPage;
+
+static AtlasPage gImageAtlasPages[SI_ATLAS_MAX_PAGES];
+static u32		 gImageAtlasPageCount = 0u;
+
+static SiTexture* gpStandaloneTextures		 = SI_NULL; ///< Textures of the images which were not packed.
+static u32		  gStandaloneTextureCount	 = 0u;
+static u32		  gStandaloneTextureCapacity = 0u;
+
+static AtlasPage* createAtlasPage(void)
+{
+	AtlasPage* pPage = &gImageAtlasPages[gImageAtlasPageCount++];
+	memset(pPage, 0, sizeof(AtlasPage));
+
+	// The blank pixels are only needed to create the texture, images are uploaded into it region by region. They also
+	// keep the padding around the images transparent.
+	u8* pBlank = (u8*)calloc(SI_ATLAS_PAGE_SIZE * SI_ATLAS_PAGE_SIZE, 4);
+	if (pBlank == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate image atlas page %u.", gImageAtlasPageCount - 1u);
+	}
+
+	pPage->texture = siCreateTexture(SI_ATLAS_PAGE_SIZE, SI_ATLAS_PAGE_SIZE, SI_TEXTURE_FORMAT_RGBA8, pBlank);
+	free(pBlank);
+
+	return pPage;
+}
+
+/**
+ * Find room for a `width` x `height` region. The tightest shelf with room left wins, then a new shelf is opened on an
+ * existing or a new page.
+ *
+ * @return `SI_FALSE` when every page is full.
+ */
+static b8 allocateAtlasRegion(u32 width, u32 height, u32* pPage, u32* pX, u32* pY)
+{
+	u32 shelfHeight = (height + ATLAS_SHELF_GRANULARITY - 1u) / ATLAS_SHELF_GRANULARITY * ATLAS_SHELF_GRANULARITY;
+
+	AtlasShelf* pBestShelf = SI_NULL;
+	for (u32 page = 0u; page < gImageAtlasPageCount; ++page)
+	{
+		AtlasPage* pPageData = &gImageAtlasPages[page];
+		for (u32 shelf = 0u; shelf < pPageData->shelfCount; ++shelf)
+		{
+			AtlasShelf* pShelf = &pPageData->shelves[shelf];
+			if (pShelf->height < shelfHeight || pShelf->height > shelfHeight + ATLAS_SHELF_GRANULARITY ||
+				pShelf->cursorX + width > SI_ATLAS_PAGE_SIZE)
+			{
+				continue;
+			}
+
+			if (pBestShelf == SI_NULL || pShelf->height < pBestShelf->height)
+			{
+				pBestShelf = pShelf;
+				*pPage	   = page;
+			}
+		}
+	}
+
+	for (u32 page = 0u; pBestShelf == SI_NULL && page <= gImageAtlasPageCount && page < SI_ATLAS_MAX_PAGES; ++page)
+	{
+		AtlasPage* pPageData = page < gImageAtlasPageCount ? &gImageAtlasPages[page] : createAtlasPage();
+		if (pPageData->nextShelfY + shelfHeight > SI_ATLAS_PAGE_SIZE)
+		{
+			continue;
+		}
+
+		pBestShelf			= &pPageData->shelves[pPageData->shelfCount++];
+		pBestShelf->y		= (u16)pPageData->nextShelfY;
+		pBestShelf->height	= (u16)shelfHeight;
+		pBestShelf->cursorX = 0u;
+		pPageData->nextShelfY += shelfHeight;
+		*pPage = page;
+	}
+
+	if (pBestShelf == SI_NULL)
+	{
+		return SI_FALSE;
+	}
+
+	*pX = pBestShelf->cursorX;
+	*pY = pBestShelf->y;
+	pBestShelf->cursorX += (u16)width;
+	return SI_TRUE;
+}
+
+static SiSprite createStandaloneImage(u32 width, u32 height, SiTextureFormat format, const void* pData)
+{
+	if (gStandaloneTextureCount == gStandaloneTextureCapacity)
+	{
+		u32 newCapacity =
+			gStandaloneTextureCapacity > 0u ? gStandaloneTextureCapacity * 2u : INITIAL_STANDALONE_CAPACITY;
+
+		SiTexture* pNewTextures = (SiTexture*)realloc(gpStandaloneTextures, sizeof(SiTexture) * newCapacity);
+		if (pNewTextures == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow the standalone atlas images to %u entries.", newCapacity);
+		}
+
+		gpStandaloneTextures	   = pNewTextures;
+		gStandaloneTextureCapacity = newCapacity;
+	}
+
+	SiSprite sprite = {0};
+	sprite.texture	= siCreateTexture(width, height, format, pData);
+	sprite.quadMin	= (SiVector2){0.0f, 0.0f};
+	sprite.quadMax	= (SiVector2){1.0f, 1.0f};
+
+	gpStandaloneTextures[gStandaloneTextureCount++] = sprite.texture;
+	return sprite;
+}
+
+SiSprite siAtlasAddImage(u32 width, u32 height, SiTextureFormat format, const void* pData)
+{
+	u32 page, x, y;
+	if (width > SI_ATLAS_MAX_IMAGE_SIZE || height > SI_ATLAS_MAX_IMAGE_SIZE ||
+		!allocateAtlasRegion(width + ATLAS_PADDING, height + ATLAS_PADDING, &page, &x, &y))
+	{
+		return createStandaloneImage(width, height, format, pData);
+	}
+
+	// The pages are RGBA8, other formats are expanded before the upload.
+	const u8* pPixels	= (const u8*)pData;
+	u8*		  pExpanded = SI_NULL;
+	if (format != SI_TEXTURE_FORMAT_RGBA8)
+	{
+		pExpanded = (u8*)malloc((size_t)width * height * 4u);
+		if (pExpanded == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to expand a %ux%u atlas image.", width, height);
+		}
+
+		for (u32 pixelIndex = 0u; pixelIndex < width * height; ++pixelIndex)
+		{
+			u8* pTarget = &pExpanded[pixelIndex * 4u];
+			if (format == SI_TEXTURE_FORMAT_RGB8)
+			{
+				pTarget[0] = pPixels[pixelIndex * 3u + 0u];
+				pTarget[1] = pPixels[pixelIndex * 3u + 1u];
+				pTarget[2] = pPixels[pixelIndex * 3u + 2u];
+				pTarget[3] = 255u;
+			}
+			else
+			{
+				pTarget[0] = 255u;
+				pTarget[1] = 255u;
+				pTarget[2] = 255u;
+				pTarget[3] = pPixels[pixelIndex];
+			}
+		}
+
+		pPixels = pExpanded;
+	}
+
+	siUpdateTexture(gImageAtlasPages[page].texture, x, y, width, height, pPixels);
+	free(pExpanded);
+
+	SiSprite sprite = {0};
+	sprite.texture	= gImageAtlasPages[page].texture;
+	sprite.quadMin	= (SiVector2){(f32)x / SI_ATLAS_PAGE_SIZE, (f32)y / SI_ATLAS_PAGE_SIZE};
+	sprite.quadMax	= (SiVector2){(f32)(x + width) / SI_ATLAS_PAGE_SIZE, (f32)(y + height) / SI_ATLAS_PAGE_SIZE};
+	return sprite;
+}
+
+#ifdef SIMUI_USE_STB
+SiSprite siAtlasLoadImage(const char* filePath)
+{
+	int width, height, channels;
+	u8* data = stbi_load(filePath, &width, &height, &channels, 4);
+	if (!data)
+	{
+		SI_ERROR_EXIT("Failed to load image file: %s", filePath);
+	}
+
+	SiSprite sprite = siAtlasAddImage((u32)width, (u32)height, SI_TEXTURE_FORMAT_RGBA8, data);
+	stbi_image_free(data);
+	return sprite;
+}
+#endif // SIMUI_USE_STB
+
+void siAtlasClear()
+{
+	for (u32 page = 0u; page < gImageAtlasPageCount; ++page)
+	{
+		siDestroyTexture(gImageAtlasPages[page].texture);
+	}
+
+	for (u32 textureIndex = 0u; textureIndex < gStandaloneTextureCount; ++textureIndex)
+	{
+		siDestroyTexture(gpStandaloneTextures[textureIndex]);
+	}
+
+	memset(gImageAtlasPages, 0, sizeof(gImageAtlasPages));
+	gImageAtlasPageCount = 0u;
+
+	free(gpStandaloneTextures);
+	gpStandaloneTextures	   = SI_NULL;
+	gStandaloneTextureCount	   = 0u;
+	gStandaloneTextureCapacity = 0u;
+}
\ No newline at end of file
@@ -3,76 +3,1616 @@
 #include "simui/simui.h"
 #include "simui/texture.h"
 #include "stdio.h"
+#include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 
-#define FONT_BUFFER_SIZE	65536
-#define FONT_TEXTURE_WIDTH	2048
-#define FONT_TEXTURE_HEIGHT 2048
+#define MAX_FONT_FACES 16
+#define MAX_FONTS	   64
+
+#define FONT_ATLAS_PAGE_SIZE	  1024
+#define FONT_ATLAS_MAX_PAGES	  4
+#define FONT_ATLAS_PADDING		  1
+#define FONT_SHELF_GRANULARITY	  8
+#define FONT_MAX_SHELVES_PER_PAGE (FONT_ATLAS_PAGE_SIZE / FONT_SHELF_GRANULARITY)
+#define FONT_OVERSAMPLING		  2
+
+#define GLYPH_CACHE_MAGIC		0x48504c47u ///< "GLPH" read as a little endian u32.
+#define GLYPH_CACHE_VERSION		2u
+#define GLYPH_CACHE_EXTENSION	".simglyph"
+#define FONT_CACHE_PATH_SIZE	512
+#define FONT_CACHE_FNV_BASIS	0xcbf29ce484222325ull
+#define FONT_CACHE_FNV_PRIME	0x100000001b3ull
+
+#define FONT_SDF_SIZE	 48.0f
+#define FONT_SDF_PADDING 6
+#define FONT_SDF_ON_EDGE 128
+
+#define MAX_GLYPH_SETS (MAX_FONTS + MAX_FONT_FACES)
 
 #define START_OFST 32
 #define END_OFST   127
+#define ASCII_SIZE (END_OFST - START_OFST)
+
+#define GLYPH_PAGE_NONE		0xFFFFu
+#define GLYPH_SLOT_NONE		0xFFFFFFFFu
+#define INITIAL_GLYPH_SLOTS 256u
+#define UTF8_REPLACEMENT	0xFFFDu
 
 #define STB_TRUETYPE_IMPLEMENTATION
 #include <stb_truetype.h>
 
-static stbtt_fontinfo g_fontInfo;
-static SiTexture	  g_fontTexture = SI_TEXTURE_NULL;
+#define FONT_VALIDATE(pFont)                                                                                           \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if ((pFont)->id >= MAX_FONTS)                                                                                  \
+		{                                                                                                              \
+			SI_ERROR_EXIT("Invalid font handle.");                                                                     \
+		}                                                                                                              \
+                                                                                                                       \
+		if (!gFonts[(pFont)->id].isUsed)                                                                               \
+		{                                                                                                              \
+			SI_ERROR_EXIT("Font handle not in use.");                                                                  \
+		}                                                                                                              \
+	} while (0)
+
+/**
+ * A font file loaded once and shared by every size it is used at.
+ */
+typedef struct FontFace
+{
+	char*		   file;								  ///< Own copy of the path of the face, used to share it.
+	SiMappedFile   mapping;								  ///< The mapped font file, referenced by `info`.
+	stbtt_fontinfo info;								  ///< The parsed font file.
+	f32			   sdfScale;							  ///< Scale from font units to distance field pixels.
+	i16			   asciiKerning[ASCII_SIZE * ASCII_SIZE]; ///< Kerning of the printable ASCII pairs in font units.
+	i16			   asciiAdvance[ASCII_SIZE];			  ///< Advance of the printable ASCII glyphs in font units.
+	i32			   boundingBox[4];						  ///< Union of the glyph boxes in font units: x0, y0, x1, y1.
+	u64			   pathHash;							  ///< FNV-1a of the path of the face, keys the glyph caches.
+	u64			   fileSize;							  ///< Size of the font file, keys the glyph cache files.
+	u64			   fileModifiedTime;					  ///< Modification time of the font file, see `siGetFileInfo`.
+	u32			   referenceCount;						  ///< The number of loaded sizes using the face.
+} FontFace;
+
+/**
+ * A face at a given pixel size, the entry a `SiFont` handle refers to.
+ *
+ * Glyphs are cached per glyph set: a bitmap font owns the set matching its handle, while every distance field size of
+ * a face shares the set `MAX_FONTS + face` rasterized at `FONT_SDF_SIZE` and scales its glyphs at lookup.
+ */
+typedef struct FontInstance
+{
+	u32					face;		   ///< Index of the face inside `gFontFaces`.
+	f32					scale;		   ///< Scale from font units to pixels.
+	SiFontRasterization	rasterization; ///< How the glyphs of the font are rasterized.
+	u16					glyphSet;	   ///< The glyph set the glyphs are cached in.
+	f32					glyphScale;	   ///< Scale from the cached glyph metrics to pixels, `1` for bitmap fonts.
+	b8					isUsed;
+} FontInstance;
+
+/**
+ * A horizontal strip of an atlas page. Glyphs of similar height are appended left to right, and the whole strip is
+ * the unit of eviction.
+ */
+typedef struct FontAtlasShelf
+{
+	u16 y;			   ///< The top row of the shelf inside the page.
+	u16 height;		   ///< The height of the shelf, rounded up to `FONT_SHELF_GRANULARITY`.
+	u16 cursorX;	   ///< The first free column of the shelf.
+	u32 lastUsedFrame; ///< The last frame one of the glyphs of the shelf was looked up.
+	u32 generation;	   ///< Unique number given every time the shelf is opened or evicted, see `SiGlyphShelf`.
+} FontAtlasShelf;
+
+/**
+ * An atlas page shared by the glyphs of every face and size, so switching fonts inside a frame does not break the
+ * text batch. Pages only live on the GPU, glyphs are rasterized into the per-frame staging buffer.
+ */
+typedef struct FontAtlasPage
+{
+	SiTexture	   texture;							   ///< The texture holding the glyphs of the page.
+	FontAtlasShelf shelves[FONT_MAX_SHELVES_PER_PAGE]; ///< The shelves of the page, top to bottom.
+	u32			   shelfCount;						   ///< The number of used entries of `shelves`.
+	u32			   nextShelfY;						   ///< The first row not covered by a shelf yet.
+} FontAtlasPage;
+
+typedef struct CachedGlyph
+{
+	u32		codepoint; ///< The codepoint of the glyph.
+	u16		glyphSet;  ///< The glyph set the glyph was rasterized for.
+	u16		page;	   ///< The atlas page holding the bitmap, `GLYPH_PAGE_NONE` for glyphs without outline.
+	u16		shelf;	   ///< The shelf of `page` holding the bitmap.
+	SiGlyph glyph;	   ///< The layout information handed out to the renderer.
+} CachedGlyph;
 
-static stbtt_packedchar glyphs[END_OFST - START_OFST]					 = {0};
-static u8				pixels[FONT_TEXTURE_WIDTH * FONT_TEXTURE_HEIGHT] = {0}; // big texture
-static f32				scale											 = 1.0f;
-static u8				buffer[FONT_BUFFER_SIZE]						 = {0};
+/**
+ * Decide whether `removeGlyphs` drops `pGlyph`, `pUserData` is the value handed to `removeGlyphs`.
+ */
+typedef b8 (*FPN_ShouldRemoveGlyph)(const CachedGlyph* pGlyph, const void* pUserData);
 
-void siFontLoad(const char* file, SiFont* pFont, f32 size)
+/**
+ * Header of a `.simglyph` file, followed by `glyphCount` entries sorted by codepoint and then by their bitmaps. A file
+ * holds the glyphs of one glyph set, identified by the font file, the scale and the rasterization.
+ */
+typedef struct GlyphCacheHeader
 {
-	pFont->file = file;
-	pFont->size = readFile(file, buffer, sizeof(buffer));
+	u32 magic;			  ///< `GLYPH_CACHE_MAGIC`.
+	u32 version;		  ///< `GLYPH_CACHE_VERSION`, bumped when the layout or the rasterization changes.
+	u64 pathHash;		  ///< `FontFace::pathHash` of the font file.
+	u64 fileSize;		  ///< `FontFace::fileSize` of the font file.
+	u64 fileModifiedTime; ///< `FontFace::fileModifiedTime` of the font file.
+	f32 scale;			  ///< Scale from font units to pixels the glyphs were rasterized at.
+	u32 rasterization;	  ///< The `SiFontRasterization` of the glyphs.
+	u32 oversampling;	  ///< `FONT_OVERSAMPLING` for bitmap glyphs.
+	u32 glyphCount;
+} GlyphCacheHeader;
 
-	if (pFont->size == 0)
+typedef struct GlyphCacheEntry
+{
+	u32		  codepoint;
+	u16		  width;	   ///< Width of the padded bitmap as uploaded to the atlas, `0` for glyphs without outline.
+	u16		  height;	   ///< Height of the padded bitmap.
+	u32		  pixelOffset; ///< Offset of the bitmap from the first bitmap of the file.
+	SiVector2 offset;	   ///< `SiGlyph::offset` of the glyph.
+	SiVector2 size;		   ///< `SiGlyph::size` of the glyph.
+} GlyphCacheEntry;
+
+/**
+ * The glyph cache file of a glyph set key, mapped while a set of the key is in use, along with the glyphs rasterized
+ * since then. Glyph sets of the same key share the cache, the new glyphs are merged into the file when the last of
+ * them is released.
+ */
+typedef struct GlyphSetCache
+{
+	GlyphCacheHeader	   header;		///< The key of the set, `glyphCount` is the one of the mapped file.
+	SiMappedFile		   file;		///< The mapped cache file, empty when missing or stale.
+	const GlyphCacheEntry* pEntries;	///< The entries of `file`.
+	const u8*			   pPixels;		///< The bitmaps of `file`.
+	GlyphCacheEntry*	   pNewEntries; ///< Glyphs rasterized since the set was opened.
+	u32					   newEntryCount;
+	u32					   newEntryCapacity;
+	u8*					   pNewPixels; ///< Bitmaps of `pNewEntries`.
+	u32					   newPixelSize;
+	u32					   newPixelCapacity;
+	u32					   refCount; ///< Number of glyph sets using the cache, `0` for a free cache.
+} GlyphSetCache;
+
+/**
+ * A glyph bitmap rasterized during the frame, waiting inside `gpStaging` to be uploaded to its atlas page.
+ */
+typedef struct PendingUpload
+{
+	u16 page;
+	u32 x;
+	u32 y;
+	u32 width;
+	u32 height;
+	u32 offset; ///< Offset of the tightly packed bitmap inside `gpStaging`.
+} PendingUpload;
+
+static FontFace		gFontFaces[MAX_FONT_FACES];
+static FontInstance gFonts[MAX_FONTS];
+static u32			gFontCount = 0u;
+static SiGlyph		gScaledGlyph;
+
+static FontAtlasPage gAtlasPages[FONT_ATLAS_MAX_PAGES];
+static u32			 gAtlasPageCount  = 0u;
+static u32			 gFontFrame		  = 0u;
+static u32			 gAtlasGeneration = 0u;
+static u32			 gShelfGeneration = 0u; ///< The last generation given to a shelf, never reset.
+
+static SiGlyphShelfSet* gpShelfCapture = SI_NULL; ///< The set `siCaptureGlyphShelves` adds looked up shelves to.
+
+/**
+ * The cached glyphs of every glyph set. Printable ASCII is found through `gAsciiSlots`, every other codepoint through
+ * the open addressing table `gpGlyphLookup` which holds `slot + 1`, `0` marking an empty bucket.
+ */
+static CachedGlyph* gpGlyphs			 = SI_NULL;
+static u32			gGlyphCount			 = 0u;
+static u32			gGlyphCapacity		 = 0u;
+static u32*			gpGlyphLookup		 = SI_NULL;
+static u32			gGlyphLookupCapacity = 0u;
+static u32			gAsciiSlots[MAX_GLYPH_SETS][ASCII_SIZE];
+
+static char			  gFontCacheDirectory[FONT_CACHE_PATH_SIZE] = {0};
+static GlyphSetCache  gGlyphCaches[MAX_GLYPH_SETS];
+static GlyphSetCache* gpGlyphSetCaches[MAX_GLYPH_SETS]; ///< The cache of every glyph set, `SI_NULL` when disabled.
+
+/**
+ * Staging memory of the glyphs rasterized during the current frame. It only lives until `siFlushFontAtlas` uploaded
+ * it, a frame drawing already cached text allocates nothing.
+ */
+static u8*			  gpStaging				 = SI_NULL;
+static u32			  gStagingSize			 = 0u;
+static u32			  gStagingCapacity		 = 0u;
+static PendingUpload* gpPendingUploads		 = SI_NULL;
+static u32			  gPendingUploadCount	 = 0u;
+static u32			  gPendingUploadCapacity = 0u;
+
+static u32	acquireFontFace(const char* file);
+static void releaseFontFace(u32 face);
+static u32	findGlyphSlot(u16 glyphSet, u32 codepoint);
+static u32	cacheGlyph(u16 glyphSet, u32 codepoint);
+static void removeGlyphs(FPN_ShouldRemoveGlyph shouldRemove, const void* pUserData);
+static void rebuildGlyphLookup(void);
+static b8	allocateAtlasRegion(u32 width, u32 height, u16* pPage, u16* pShelf, u32* pX, u32* pY);
+static void captureShelf(u16 page, u16 shelf);
+static void releaseStaging(void);
+
+static void openGlyphSetCache(u16 glyphSet, const FontFace* pFace, f32 scale, SiFontRasterization rasterization);
+static void closeGlyphSetCache(u16 glyphSet);
+static b8	restoreCachedGlyph(u16 glyphSet, const GlyphCacheEntry* pEntry, CachedGlyph* pCachedGlyph);
+static void recordCachedGlyph(u16 glyphSet, const CachedGlyph* pCachedGlyph);
+
+static const GlyphCacheEntry* findGlyphCacheEntry(u16 glyphSet, u32 codepoint);
+
+void siFontLoad(const char* file, SiFont* pFont, f32 size, SiFontRasterization rasterization)
+{
+	// The glyph cache is shared with the render thread, which rasterizes glyphs while drawing.
+	siAcquireRenderContext();
+
+	u32 id = 0u;
+	for (id = 0u; id < MAX_FONTS; ++id)
 	{
-		SI_ERROR_EXIT("Failed to read font file: %s", file);
+		if (!gFonts[id].isUsed)
+		{
+			break;
+		}
 	}
 
-	if (!stbtt_InitFont(&g_fontInfo, buffer, stbtt_GetFontOffsetForIndex(buffer, 0)))
+	if (id == MAX_FONTS)
 	{
-		SI_ERROR_EXIT("Failed to initialize font: %s", file);
+		SI_ERROR_EXIT("Too many fonts loaded, failed to load: %s", file);
+	}
+
+	FontInstance* pInstance = &gFonts[id];
+	memset(pInstance, 0, sizeof(FontInstance));
+
+	pInstance->face	  = acquireFontFace(file);
+	pInstance->isUsed = SI_TRUE;
+	gFontCount++;
+
+	FontFace* pFace			 = &gFontFaces[pInstance->face];
+	pInstance->scale		 = stbtt_ScaleForPixelHeight(&pFace->info, size);
+	pInstance->rasterization = rasterization;
+
+	// Nothing is rasterized here, glyphs are cached the first time they are drawn.
+	if (rasterization == SI_FONT_RASTERIZATION_SDF)
+	{
+		pInstance->glyphSet	  = (u16)(MAX_FONTS + pInstance->face);
+		pInstance->glyphScale = pInstance->scale / pFace->sdfScale;
+	}
+	else
+	{
+		pInstance->glyphSet	  = (u16)id;
+		pInstance->glyphScale = 1.0f;
+
+		for (u32 asciiIndex = 0u; asciiIndex < ASCII_SIZE; ++asciiIndex)
+		{
+			gAsciiSlots[id][asciiIndex] = GLYPH_SLOT_NONE;
+		}
+
+		openGlyphSetCache((u16)id, pFace, pInstance->scale, rasterization);
+	}
+
+	i32 ascent, descent, lineGap;
+	stbtt_GetFontVMetrics(&pFace->info, &ascent, &descent, &lineGap);
+
+	pFont->id			 = id;
+	pFont->file			 = file;
+	pFont->size			 = (u32)pFace->mapping.size;
+	pFont->sizeInPixels	 = size;
+	pFont->rasterization = rasterization;
+	pFont->ascent		 = ascent * pInstance->scale;
+	pFont->descent		 = descent * pInstance->scale;
+	pFont->lineGap		 = lineGap * pInstance->scale;
+
+	siReleaseRenderContext();
+}
+
+const SiGlyph* siGetFontGlyph(SiFont* pFont, u32 codepoint)
+{
+	FONT_VALIDATE(pFont);
+
+	FontInstance* pInstance = &gFonts[pFont->id];
+
+	u32 slot = findGlyphSlot(pInstance->glyphSet, codepoint);
+	if (slot == GLYPH_SLOT_NONE)
+	{
+		slot = cacheGlyph(pInstance->glyphSet, codepoint);
+		if (slot == GLYPH_SLOT_NONE)
+		{
+			return SI_NULL;
+		}
 	}
 
-	scale				= stbtt_ScaleForPixelHeight(&g_fontInfo, size);
-	pFont->sizeInPixels = size;
+	CachedGlyph* pCachedGlyph = &gpGlyphs[slot];
+	if (pCachedGlyph->page != GLYPH_PAGE_NONE)
+	{
+		gAtlasPages[pCachedGlyph->page].shelves[pCachedGlyph->shelf].lastUsedFrame = gFontFrame;
 
-	stbtt_pack_context pc;
-	stbtt_PackBegin(&pc, pixels, FONT_TEXTURE_WIDTH, FONT_TEXTURE_HEIGHT, 0, 1, NULL);
-	stbtt_PackSetOversampling(&pc, 2, 2);
-	stbtt_PackFontRange(&pc, buffer, 0, pFont->sizeInPixels, START_OFST, END_OFST - START_OFST, glyphs);
-	stbtt_PackEnd(&pc);
+		if (gpShelfCapture != SI_NULL)
+		{
+			captureShelf(pCachedGlyph->page, pCachedGlyph->shelf);
+		}
+	}
 
-	g_fontTexture = siCreateTexture(FONT_TEXTURE_WIDTH, FONT_TEXTURE_HEIGHT, SI_TEXTURE_FORMAT_R8, pixels);
+	if (pInstance->glyphScale == 1.0f)
+	{
+		return &pCachedGlyph->glyph;
+	}
+
+	// Distance field glyphs are shared by every size of the face, their metrics are scaled to the size of the font.
+	gScaledGlyph = pCachedGlyph->glyph;
+	gScaledGlyph.offset.x *= pInstance->glyphScale;
+	gScaledGlyph.offset.y *= pInstance->glyphScale;
+	gScaledGlyph.size.x *= pInstance->glyphScale;
+	gScaledGlyph.size.y *= pInstance->glyphScale;
+	gScaledGlyph.advance *= pInstance->glyphScale;
+	return &gScaledGlyph;
 }
 
-SiSprite siGetFontSprite(SiFont* pFont, i8 character)
+f32 siGetFontKerning(SiFont* pFont, u32 left, u32 right)
 {
-	stbtt_aligned_quad quad;
+	FONT_VALIDATE(pFont);
 
-	f32 xpos = 0.0f;
-	f32 ypos = 0.0f;
+	FontInstance* pInstance = &gFonts[pFont->id];
+	FontFace*	  pFace		= &gFontFaces[pInstance->face];
 
-	stbtt_GetPackedQuad(
-		glyphs, FONT_TEXTURE_WIDTH, FONT_TEXTURE_HEIGHT, character - START_OFST, &xpos, &ypos, &quad, 0);
+	u32 leftIndex  = left - START_OFST;
+	u32 rightIndex = right - START_OFST;
+	if (leftIndex < ASCII_SIZE && rightIndex < ASCII_SIZE)
+	{
+		return pFace->asciiKerning[leftIndex * ASCII_SIZE + rightIndex] * pInstance->scale;
+	}
 
+	return stbtt_GetCodepointKernAdvance(&pFace->info, (i32)left, (i32)right) * pInstance->scale;
+}
+
+SiVector4 siGetTextBounds(SiFont* pFont, f32 x, f32 y, const char* text)
+{
+	FONT_VALIDATE(pFont);
+
+	FontInstance* pInstance = &gFonts[pFont->id];
+	FontFace*	  pFace		= &gFontFaces[pInstance->face];
+
+	f32			width			  = 0.0f;
+	const char* pText			  = text;
+	u32			codepoint		  = 0u;
+	u32			previousCodepoint = 0u;
+	while ((codepoint = siDecodeUtf8(&pText)) != 0u)
+	{
+		if (previousCodepoint != 0u)
+		{
+			width += siGetFontKerning(pFont, previousCodepoint, codepoint);
+		}
+
+		i32 advance	   = 0;
+		u32 asciiIndex = codepoint - START_OFST;
+		if (asciiIndex < ASCII_SIZE)
+		{
+			advance = pFace->asciiAdvance[asciiIndex];
+		}
+		else
+		{
+			i32 leftSideBearing;
+			stbtt_GetCodepointHMetrics(&pFace->info, (i32)codepoint, &advance, &leftSideBearing);
+		}
+
+		width += advance * pInstance->scale;
+		previousCodepoint = codepoint;
+	}
+
+	// Any glyph fits into the bounding box of the face around its pen position, which covers overhangs past the first
+	// and the last pen positions. The extra pixel absorbs the rounding of the rasterized glyph boxes.
+	f32		  baseline = y - pFont->descent;
+	f32		  scale	   = pInstance->scale;
+	SiVector4 bounds   = {};
+	bounds.x		   = x + (pFace->boundingBox[0] < 0 ? pFace->boundingBox[0] * scale : 0.0f) - 1.0f;
+	bounds.y		   = baseline + pFace->boundingBox[1] * scale - 1.0f;
+	bounds.z		   = x + width + (pFace->boundingBox[2] > 0 ? pFace->boundingBox[2] * scale : 0.0f) + 1.0f;
+	bounds.w		   = baseline + pFace->boundingBox[3] * scale + 1.0f;
+	return bounds;
+}
+
+void siLayoutText(SiFont* pFont, f32 x, f32 y, const char* text, FPN_SiLayoutGlyph glyphFunction, void* pUserData)
+{
+	// The renderers work with y pointing up while the glyph offsets point down.
+	f32 penX	 = x;
+	f32 baseline = y - pFont->descent;
+
+	const char* pText			  = text;
+	u32			codepoint		  = 0u;
+	u32			previousCodepoint = 0u;
+	while ((codepoint = siDecodeUtf8(&pText)) != 0u)
+	{
+		const SiGlyph* pGlyph = siGetFontGlyph(pFont, codepoint);
+		if (pGlyph == SI_NULL)
+		{
+			previousCodepoint = 0u;
+			continue;
+		}
+
+		if (previousCodepoint != 0u)
+		{
+			penX += siGetFontKerning(pFont, previousCodepoint, codepoint);
+		}
+
+		if (pGlyph->size.x > 0.0f)
+		{
+			SiVector2 center = {penX + pGlyph->offset.x + pGlyph->size.x / 2.0f,
+								baseline - pGlyph->offset.y - pGlyph->size.y / 2.0f};
+			glyphFunction(pGlyph, center, pUserData);
+		}
+
+		penX += pGlyph->advance;
+		previousCodepoint = codepoint;
+	}
+}
+
+SiSprite siGetFontSprite(SiFont* pFont, u32 codepoint)
+{
 	SiSprite sprite = {};
-	sprite.texture	= g_fontTexture;
-	sprite.quadMin	= (SiVector2){quad.s0, quad.t0};
-	sprite.quadMax	= (SiVector2){quad.s1, quad.t1};
+	sprite.texture	= SI_TEXTURE_NULL;
+
+	const SiGlyph* pGlyph = siGetFontGlyph(pFont, codepoint);
+	if (pGlyph != SI_NULL)
+	{
+		sprite.texture = pGlyph->texture;
+		sprite.quadMin = pGlyph->quadMin;
+		sprite.quadMax = pGlyph->quadMax;
+	}
 
 	return sprite;
 }
 
+void siFlushFontAtlas()
+{
+	for (u32 uploadIndex = 0u; uploadIndex < gPendingUploadCount; ++uploadIndex)
+	{
+		PendingUpload* pUpload = &gpPendingUploads[uploadIndex];
+		siUpdateTexture(gAtlasPages[pUpload->page].texture,
+						pUpload->x,
+						pUpload->y,
+						pUpload->width,
+						pUpload->height,
+						&gpStaging[pUpload->offset]);
+	}
+
+	releaseStaging();
+	gFontFrame++;
+}
+
+u32 siGetFontAtlasGeneration()
+{
+	return gAtlasGeneration;
+}
+
+void siCaptureGlyphShelves(SiGlyphShelfSet* pSet)
+{
+	if (pSet != SI_NULL)
+	{
+		pSet->count = 0u;
+	}
+
+	gpShelfCapture = pSet;
+}
+
+void siTouchGlyphShelves(const SiGlyphShelfSet* pSet)
+{
+	for (u32 shelfIndex = 0u; shelfIndex < pSet->count; ++shelfIndex)
+	{
+		const SiGlyphShelf* pShelf = &pSet->pShelves[shelfIndex];
+		if (pShelf->page < gAtlasPageCount && pShelf->shelf < gAtlasPages[pShelf->page].shelfCount)
+		{
+			gAtlasPages[pShelf->page].shelves[pShelf->shelf].lastUsedFrame = gFontFrame;
+		}
+	}
+}
+
+b8 siAreGlyphShelvesValid(const SiGlyphShelfSet* pSet)
+{
+	for (u32 shelfIndex = 0u; shelfIndex < pSet->count; ++shelfIndex)
+	{
+		const SiGlyphShelf* pShelf = &pSet->pShelves[shelfIndex];
+		if (pShelf->page >= gAtlasPageCount || pShelf->shelf >= gAtlasPages[pShelf->page].shelfCount ||
+			gAtlasPages[pShelf->page].shelves[pShelf->shelf].generation != pShelf->generation)
+		{
+			return SI_FALSE;
+		}
+	}
+
+	return SI_TRUE;
+}
+
+u32 siDecodeUtf8(const char** ppText)
+{
+	const u8* pText = (const u8*)*ppText;
+	u32		  lead	= pText[0];
+
+	if (lead == 0u)
+	{
+		return 0u;
+	}
+
+	u32 length	  = 1u;
+	u32 codepoint = lead;
+	u32 minimum	  = 0u;
+
+	if (lead >= 0xF0u && lead <= 0xF4u)
+	{
+		length	  = 4u;
+		codepoint = lead & 0x07u;
+		minimum	  = 0x10000u;
+	}
+	else if (lead >= 0xE0u && lead <= 0xEFu)
+	{
+		length	  = 3u;
+		codepoint = lead & 0x0Fu;
+		minimum	  = 0x800u;
+	}
+	else if (lead >= 0xC2u && lead <= 0xDFu)
+	{
+		length	  = 2u;
+		codepoint = lead & 0x1Fu;
+		minimum	  = 0x80u;
+	}
+	else if (lead >= 0x80u)
+	{
+		// Stray continuation byte or an invalid lead byte.
+		*ppText += 1;
+		return UTF8_REPLACEMENT;
+	}
+
+	for (u32 index = 1u; index < length; ++index)
+	{
+		if ((pText[index] & 0xC0u) != 0x80u)
+		{
+			// Truncated sequence, resume at the offending byte so the terminator is never skipped.
+			*ppText += index;
+			return UTF8_REPLACEMENT;
+		}
+
+		codepoint = (codepoint << 6) | (pText[index] & 0x3Fu);
+	}
+
+	*ppText += length;
+
+	if (codepoint < minimum || codepoint > 0x10FFFFu || (codepoint >= 0xD800u && codepoint <= 0xDFFFu))
+	{
+		return UTF8_REPLACEMENT;
+	}
+
+	return codepoint;
+}
+
+static b8 isGlyphOfSet(const CachedGlyph* pGlyph, const void* pGlyphSet)
+{
+	return pGlyph->glyphSet == *(const u16*)pGlyphSet;
+}
+
 void siFontUnload(SiFont* pFont)
 {
-	if (g_fontTexture != SI_TEXTURE_NULL)
+	FONT_VALIDATE(pFont);
+
+	siAcquireRenderContext();
+
+	// The atlas space of the glyphs is not reclaimed right away, their shelves simply stop being used and are the
+	// first ones to be evicted. Distance field glyphs are shared by the face and go away with it.
+	if (gFonts[pFont->id].rasterization != SI_FONT_RASTERIZATION_SDF)
 	{
-		siDestroyTexture(g_fontTexture);
-		g_fontTexture = SI_TEXTURE_NULL;
+		u16 glyphSet = (u16)pFont->id;
+		closeGlyphSetCache(glyphSet);
+		removeGlyphs(isGlyphOfSet, &glyphSet);
+	}
+
+	releaseFontFace(gFonts[pFont->id].face);
+	memset(&gFonts[pFont->id], 0, sizeof(FontInstance));
+	pFont->id = MAX_FONTS;
+
+	if (--gFontCount > 0u)
+	{
+		siReleaseRenderContext();
+		return;
+	}
+
+	for (u32 pageIndex = 0u; pageIndex < gAtlasPageCount; ++pageIndex)
+	{
+		siDestroyTexture(gAtlasPages[pageIndex].texture);
+	}
+
+	memset(gAtlasPages, 0, sizeof(gAtlasPages));
+	gAtlasPageCount = 0u;
+
+	free(gpGlyphs);
+	free(gpGlyphLookup);
+	gpGlyphs			 = SI_NULL;
+	gpGlyphLookup		 = SI_NULL;
+	gGlyphCount			 = 0u;
+	gGlyphCapacity		 = 0u;
+	gGlyphLookupCapacity = 0u;
+
+	releaseStaging();
+
+	siReleaseRenderContext();
+}
+
+/**
+ * Find the face loaded from `file` or load it. Faces are shared by path, so several sizes of the same font keep a
+ * single copy of the font file.
+ */
+static u32 acquireFontFace(const char* file)
+{
+	u32 freeFace = MAX_FONT_FACES;
+	for (u32 face = 0u; face < MAX_FONT_FACES; ++face)
+	{
+		if (gFontFaces[face].referenceCount == 0u)
+		{
+			freeFace = freeFace == MAX_FONT_FACES ? face : freeFace;
+			continue;
+		}
+
+		if (strcmp(gFontFaces[face].file, file) == 0)
+		{
+			gFontFaces[face].referenceCount++;
+			return face;
+		}
+	}
+
+	if (freeFace == MAX_FONT_FACES)
+	{
+		SI_ERROR_EXIT("Too many font faces loaded, failed to load: %s", file);
+	}
+
+	FontFace* pFace = &gFontFaces[freeFace];
+	memset(pFace, 0, sizeof(FontFace));
+
+	// stb_truetype reads straight from the mapping, the system only pages in the parts of the font it touches.
+	if (!siMapFile(file, &pFace->mapping))
+	{
+		SI_ERROR_EXIT("Failed to read font file: %s", file);
+	}
+
+	const u8* pData = pFace->mapping.pData;
+	if (!stbtt_InitFont(&pFace->info, pData, stbtt_GetFontOffsetForIndex(pData, 0)))
+	{
+		SI_ERROR_EXIT("Failed to initialize font: %s", file);
+	}
+
+	pFace->sdfScale = stbtt_ScaleForPixelHeight(&pFace->info, FONT_SDF_SIZE);
+	if (gFontCacheDirectory[0] != '\0')
+	{
+		// The path, size and modification time key the cache, the contents of the font are never read for it.
+		if (!siGetFileInfo(file, &pFace->fileSize, &pFace->fileModifiedTime))
+		{
+			SI_ERROR_EXIT("Failed to read font file: %s", file);
+		}
+
+		pFace->pathHash = FONT_CACHE_FNV_BASIS;
+		for (const char* pCharacter = file; *pCharacter != '\0'; ++pCharacter)
+		{
+			pFace->pathHash ^= (u8)*pCharacter;
+			pFace->pathHash *= FONT_CACHE_FNV_PRIME;
+		}
+	}
+
+	for (u32 asciiIndex = 0u; asciiIndex < ASCII_SIZE; ++asciiIndex)
+	{
+		gAsciiSlots[MAX_FONTS + freeFace][asciiIndex] = GLYPH_SLOT_NONE;
+	}
+
+	// The ASCII kerning pairs are hit on almost every string, they are kept in font units so every size shares them.
+	for (u32 left = 0u; left < ASCII_SIZE; ++left)
+	{
+		i32 advance, leftSideBearing;
+		stbtt_GetCodepointHMetrics(&pFace->info, (i32)(START_OFST + left), &advance, &leftSideBearing);
+		pFace->asciiAdvance[left] = (i16)advance;
+
+		for (u32 right = 0u; right < ASCII_SIZE; ++right)
+		{
+			pFace->asciiKerning[left * ASCII_SIZE + right] = (i16)stbtt_GetCodepointKernAdvance(
+				&pFace->info, (i32)(START_OFST + left), (i32)(START_OFST + right));
+		}
 	}
+
+	stbtt_GetFontBoundingBox(
+		&pFace->info, &pFace->boundingBox[0], &pFace->boundingBox[1], &pFace->boundingBox[2], &pFace->boundingBox[3]);
+
+	// The caller's path may be a temporary buffer, the face keeps its own copy to compare later loads against.
+	pFace->file = (char*)malloc(strlen(file) + 1u);
+	if (pFace->file == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate the path of font face: %s", file);
+	}
+	strcpy(pFace->file, file);
+	pFace->referenceCount = 1u;
+
+	openGlyphSetCache((u16)(MAX_FONTS + freeFace), pFace, pFace->sdfScale, SI_FONT_RASTERIZATION_SDF);
+	return freeFace;
+}
+
+static void releaseFontFace(u32 face)
+{
+	FontFace* pFace = &gFontFaces[face];
+	if (--pFace->referenceCount > 0u)
+	{
+		return;
+	}
+
+	u16 glyphSet = (u16)(MAX_FONTS + face);
+	closeGlyphSetCache(glyphSet);
+	removeGlyphs(isGlyphOfSet, &glyphSet);
+	siUnmapFile(&pFace->mapping);
+	free(pFace->file);
+	memset(pFace, 0, sizeof(FontFace));
+}
+
+static u32 hashGlyphKey(u16 glyphSet, u32 codepoint)
+{
+	// Codepoints fit in 21 bits, the glyph set takes the remaining ones.
+	return (codepoint | ((u32)glyphSet << 21)) * 2654435761u;
+}
+
+static u32 findGlyphSlot(u16 glyphSet, u32 codepoint)
+{
+	u32 asciiIndex = codepoint - START_OFST;
+	if (asciiIndex < ASCII_SIZE)
+	{
+		return gAsciiSlots[glyphSet][asciiIndex];
+	}
+
+	if (gGlyphLookupCapacity == 0u)
+	{
+		return GLYPH_SLOT_NONE;
+	}
+
+	u32 mask = gGlyphLookupCapacity - 1u;
+	for (u32 bucket = hashGlyphKey(glyphSet, codepoint) & mask;; bucket = (bucket + 1u) & mask)
+	{
+		u32 entry = gpGlyphLookup[bucket];
+		if (entry == 0u)
+		{
+			return GLYPH_SLOT_NONE;
+		}
+
+		CachedGlyph* pGlyph = &gpGlyphs[entry - 1u];
+		if (pGlyph->codepoint == codepoint && pGlyph->glyphSet == glyphSet)
+		{
+			return entry - 1u;
+		}
+	}
+}
+
+static void insertGlyphLookup(u32 slot)
+{
+	CachedGlyph* pGlyph		= &gpGlyphs[slot];
+	u32			 asciiIndex = pGlyph->codepoint - START_OFST;
+	if (asciiIndex < ASCII_SIZE)
+	{
+		gAsciiSlots[pGlyph->glyphSet][asciiIndex] = slot;
+		return;
+	}
+
+	u32 mask   = gGlyphLookupCapacity - 1u;
+	u32 bucket = hashGlyphKey(pGlyph->glyphSet, pGlyph->codepoint) & mask;
+	while (gpGlyphLookup[bucket] != 0u)
+	{
+		bucket = (bucket + 1u) & mask;
+	}
+
+	gpGlyphLookup[bucket] = slot + 1u;
+}
+
+/**
+ * Rebuild the ASCII tables and the hash table from the glyph slots. The hash table is kept at most half full, it is
+ * only rebuilt when it grows or after glyphs were removed and the slots compacted.
+ */
+static void rebuildGlyphLookup(void)
+{
+	u32 requiredCapacity = gGlyphLookupCapacity > 0u ? gGlyphLookupCapacity : INITIAL_GLYPH_SLOTS * 2u;
+	while (requiredCapacity < gGlyphCapacity * 2u)
+	{
+		requiredCapacity *= 2u;
+	}
+
+	if (requiredCapacity != gGlyphLookupCapacity)
+	{
+		free(gpGlyphLookup);
+		gpGlyphLookup		 = (u32*)malloc(sizeof(u32) * requiredCapacity);
+		gGlyphLookupCapacity = requiredCapacity;
+
+		if (gpGlyphLookup == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to allocate the glyph lookup table.");
+		}
+	}
+
+	memset(gpGlyphLookup, 0, sizeof(u32) * gGlyphLookupCapacity);
+	for (u32 glyphSet = 0u; glyphSet < MAX_GLYPH_SETS; ++glyphSet)
+	{
+		for (u32 asciiIndex = 0u; asciiIndex < ASCII_SIZE; ++asciiIndex)
+		{
+			gAsciiSlots[glyphSet][asciiIndex] = GLYPH_SLOT_NONE;
+		}
+	}
+
+	for (u32 slot = 0u; slot < gGlyphCount; ++slot)
+	{
+		insertGlyphLookup(slot);
+	}
+}
+
+/**
+ * Drop every cached glyph for which `shouldRemove` returns `SI_TRUE`, compact the slots and rebuild the lookup
+ * tables. This is O(cached glyphs) but only happens on eviction or when a font is unloaded.
+ */
+static void removeGlyphs(FPN_ShouldRemoveGlyph shouldRemove, const void* pUserData)
+{
+	u32 keptCount = 0u;
+	for (u32 slot = 0u; slot < gGlyphCount; ++slot)
+	{
+		if (!shouldRemove(&gpGlyphs[slot], pUserData))
+		{
+			gpGlyphs[keptCount++] = gpGlyphs[slot];
+		}
+	}
+
+	if (keptCount != gGlyphCount)
+	{
+		gAtlasGeneration++;
+	}
+
+	gGlyphCount = keptCount;
+	rebuildGlyphLookup();
+}
+
+/**
+ * Reserve `width * height` zeroed bytes of staging memory and queue their upload to `page`.
+ *
+ * @return The offset of the reserved bytes inside `gpStaging`.
+ */
+static u32 stageUpload(u16 page, u32 x, u32 y, u32 width, u32 height)
+{
+	u32 size = width * height;
+	if (gStagingSize + size > gStagingCapacity)
+	{
+		u32 newCapacity = gStagingCapacity > 0u ? gStagingCapacity : 16u * 1024u;
+		while (newCapacity < gStagingSize + size)
+		{
+			newCapacity *= 2u;
+		}
+
+		u8* pNewStaging = (u8*)realloc(gpStaging, newCapacity);
+		if (pNewStaging == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow the font staging buffer to %u bytes.", newCapacity);
+		}
+
+		gpStaging		 = pNewStaging;
+		gStagingCapacity = newCapacity;
+	}
+
+	if (gPendingUploadCount == gPendingUploadCapacity)
+	{
+		u32			   newCapacity = gPendingUploadCapacity > 0u ? gPendingUploadCapacity * 2u : 64u;
+		PendingUpload* pNewUploads = (PendingUpload*)realloc(gpPendingUploads, sizeof(PendingUpload) * newCapacity);
+		if (pNewUploads == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow the font upload queue to %u uploads.", newCapacity);
+		}
+
+		gpPendingUploads	   = pNewUploads;
+		gPendingUploadCapacity = newCapacity;
+	}
+
+	PendingUpload* pUpload = &gpPendingUploads[gPendingUploadCount++];
+	pUpload->page		   = page;
+	pUpload->x			   = x;
+	pUpload->y			   = y;
+	pUpload->width		   = width;
+	pUpload->height		   = height;
+	pUpload->offset		   = gStagingSize;
+
+	memset(&gpStaging[gStagingSize], 0, size);
+	gStagingSize += size;
+
+	return pUpload->offset;
+}
+
+static void releaseStaging(void)
+{
+	free(gpStaging);
+	free(gpPendingUploads);
+	gpStaging			   = SI_NULL;
+	gpPendingUploads	   = SI_NULL;
+	gStagingSize		   = 0u;
+	gStagingCapacity	   = 0u;
+	gPendingUploadCount	   = 0u;
+	gPendingUploadCapacity = 0u;
+}
+
+/**
+ * Reserve the atlas region of a `width` x `height` glyph bitmap and fill in where the glyph lives.
+ *
+ * @return Where to write the bitmap inside the staging buffer, with a stride of `*pStride`, or `SI_NULL` when no
+ *         atlas space could be found or reclaimed.
+ */
+static u8* reserveGlyphRegion(u32 width, u32 height, CachedGlyph* pCachedGlyph, u32* pStride)
+{
+	u16 page, shelf;
+	u32 x, y;
+	if (!allocateAtlasRegion(width + FONT_ATLAS_PADDING, height + FONT_ATLAS_PADDING, &page, &shelf, &x, &y))
+	{
+		return SI_NULL;
+	}
+
+	// The padding is uploaded as well, evicted shelves still hold old bitmaps that must not bleed into the glyph.
+	*pStride   = width + FONT_ATLAS_PADDING;
+	u32 offset = stageUpload(page, x, y, *pStride, height + FONT_ATLAS_PADDING);
+
+	pCachedGlyph->page			= page;
+	pCachedGlyph->shelf			= shelf;
+	pCachedGlyph->glyph.texture = gAtlasPages[page].texture;
+	pCachedGlyph->glyph.quadMin = (SiVector2){(f32)x / FONT_ATLAS_PAGE_SIZE, (f32)y / FONT_ATLAS_PAGE_SIZE};
+	pCachedGlyph->glyph.quadMax =
+		(SiVector2){(f32)(x + width) / FONT_ATLAS_PAGE_SIZE, (f32)(y + height) / FONT_ATLAS_PAGE_SIZE};
+
+	return &gpStaging[offset];
+}
+
+static b8 rasterizeBitmapGlyph(stbtt_fontinfo* pInfo, f32 scale, i32 glyphIndex, CachedGlyph* pCachedGlyph)
+{
+	i32 x0, y0, x1, y1;
+	stbtt_GetGlyphBitmapBoxSubpixel(
+		pInfo, glyphIndex, scale * FONT_OVERSAMPLING, scale * FONT_OVERSAMPLING, 0.0f, 0.0f, &x0, &y0, &x1, &y1);
+
+	if (stbtt_IsGlyphEmpty(pInfo, glyphIndex) || x1 <= x0 || y1 <= y0)
+	{
+		return SI_TRUE;
+	}
+
+	// Oversampling widens the bitmap by `FONT_OVERSAMPLING - 1` texels for the box filter.
+	u32 width  = (u32)(x1 - x0) + FONT_OVERSAMPLING - 1u;
+	u32 height = (u32)(y1 - y0) + FONT_OVERSAMPLING - 1u;
+
+	u32 stride	= 0u;
+	u8* pPixels = reserveGlyphRegion(width, height, pCachedGlyph, &stride);
+	if (pPixels == SI_NULL)
+	{
+		return SI_FALSE;
+	}
+
+	f32 subX, subY;
+	stbtt_MakeGlyphBitmapSubpixelPrefilter(pInfo,
+										   pPixels,
+										   (i32)width,
+										   (i32)height,
+										   (i32)stride,
+										   scale * FONT_OVERSAMPLING,
+										   scale * FONT_OVERSAMPLING,
+										   0.0f,
+										   0.0f,
+										   FONT_OVERSAMPLING,
+										   FONT_OVERSAMPLING,
+										   &subX,
+										   &subY,
+										   glyphIndex);
+
+	pCachedGlyph->glyph.offset = (SiVector2){(f32)x0 / FONT_OVERSAMPLING + subX, (f32)y0 / FONT_OVERSAMPLING + subY};
+	pCachedGlyph->glyph.size   = (SiVector2){(f32)width / FONT_OVERSAMPLING, (f32)height / FONT_OVERSAMPLING};
+	return SI_TRUE;
+}
+
+/**
+ * Rasterize a signed distance field of the glyph: the outline sits at `FONT_SDF_ON_EDGE` and the distance fades out
+ * over `FONT_SDF_PADDING` pixels on both sides, which leaves room for the text shader to anti-alias at any scale.
+ */
+static b8 rasterizeSdfGlyph(stbtt_fontinfo* pInfo, f32 scale, i32 glyphIndex, CachedGlyph* pCachedGlyph)
+{
+	i32 width, height, xOffset, yOffset;
+	u8* pField = stbtt_GetGlyphSDF(pInfo,
+								   scale,
+								   glyphIndex,
+								   FONT_SDF_PADDING,
+								   FONT_SDF_ON_EDGE,
+								   (f32)FONT_SDF_ON_EDGE / FONT_SDF_PADDING,
+								   &width,
+								   &height,
+								   &xOffset,
+								   &yOffset);
+
+	if (pField == SI_NULL)
+	{
+		return SI_TRUE;
+	}
+
+	u32 stride	= 0u;
+	u8* pPixels = reserveGlyphRegion((u32)width, (u32)height, pCachedGlyph, &stride);
+	if (pPixels != SI_NULL)
+	{
+		for (i32 row = 0; row < height; ++row)
+		{
+			memcpy(&pPixels[row * stride], &pField[row * width], (size_t)width);
+		}
+
+		pCachedGlyph->glyph.offset = (SiVector2){(f32)xOffset, (f32)yOffset};
+		pCachedGlyph->glyph.size   = (SiVector2){(f32)width, (f32)height};
+	}
+
+	stbtt_FreeSDF(pField, SI_NULL);
+	return pPixels != SI_NULL;
+}
+
+/**
+ * Rasterize `codepoint` of `glyphSet` into the staging buffer, reserve its atlas region and append it to the glyph
+ * cache.
+ *
+ * @return The slot of the new glyph, or `GLYPH_SLOT_NONE` when no atlas space could be found or reclaimed.
+ */
+static u32 cacheGlyph(u16 glyphSet, u32 codepoint)
+{
+	b8		  isSdf = glyphSet >= MAX_FONTS;
+	FontFace* pFace = isSdf ? &gFontFaces[glyphSet - MAX_FONTS] : &gFontFaces[gFonts[glyphSet].face];
+	f32		  scale = isSdf ? pFace->sdfScale : gFonts[glyphSet].scale;
+
+	CachedGlyph cachedGlyph	  = {};
+	cachedGlyph.codepoint	  = codepoint;
+	cachedGlyph.glyphSet	  = glyphSet;
+	cachedGlyph.page		  = GLYPH_PAGE_NONE;
+	cachedGlyph.glyph.texture = SI_TEXTURE_NULL;
+
+	i32 glyphIndex = stbtt_FindGlyphIndex(&pFace->info, (i32)codepoint);
+
+	i32 advance, leftSideBearing;
+	stbtt_GetGlyphHMetrics(&pFace->info, glyphIndex, &advance, &leftSideBearing);
+	cachedGlyph.glyph.advance = advance * scale;
+
+	b8					   isRasterized = SI_FALSE;
+	const GlyphCacheEntry* pEntry		= findGlyphCacheEntry(glyphSet, codepoint);
+	if (pEntry != SI_NULL)
+	{
+		isRasterized = restoreCachedGlyph(glyphSet, pEntry, &cachedGlyph);
+	}
+	else
+	{
+		isRasterized = isSdf ? rasterizeSdfGlyph(&pFace->info, scale, glyphIndex, &cachedGlyph)
+							 : rasterizeBitmapGlyph(&pFace->info, scale, glyphIndex, &cachedGlyph);
+		if (isRasterized)
+		{
+			recordCachedGlyph(glyphSet, &cachedGlyph);
+		}
+	}
+
+	if (!isRasterized)
+	{
+		siPrintWarning("Font atlas is full, glyph U+%04X is skipped.", codepoint);
+		return GLYPH_SLOT_NONE;
+	}
+
+	if (gGlyphCount == gGlyphCapacity)
+	{
+		u32			 newCapacity = gGlyphCapacity > 0u ? gGlyphCapacity * 2u : INITIAL_GLYPH_SLOTS;
+		CachedGlyph* pNewGlyphs	 = (CachedGlyph*)realloc(gpGlyphs, sizeof(CachedGlyph) * newCapacity);
+		if (pNewGlyphs == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow the glyph cache to %u glyphs.", newCapacity);
+		}
+
+		gpGlyphs	   = pNewGlyphs;
+		gGlyphCapacity = newCapacity;
+	}
+
+	u32 slot	   = gGlyphCount++;
+	gpGlyphs[slot] = cachedGlyph;
+
+	if (gGlyphCapacity * 2u > gGlyphLookupCapacity)
+	{
+		rebuildGlyphLookup();
+	}
+	else
+	{
+		insertGlyphLookup(slot);
+	}
+
+	return slot;
+}
+
+static FontAtlasPage* createAtlasPage(void)
+{
+	FontAtlasPage* pPage = &gAtlasPages[gAtlasPageCount++];
+	memset(pPage, 0, sizeof(FontAtlasPage));
+
+	// The blank pixels are only needed to create the texture, glyphs are uploaded into it region by region.
+	u8* pBlank = (u8*)calloc(FONT_ATLAS_PAGE_SIZE * FONT_ATLAS_PAGE_SIZE, 1);
+	if (pBlank == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate font atlas page %u.", gAtlasPageCount - 1u);
+	}
+
+	pPage->texture = siCreateTexture(FONT_ATLAS_PAGE_SIZE, FONT_ATLAS_PAGE_SIZE, SI_TEXTURE_FORMAT_R8, pBlank);
+	free(pBlank);
+
+	return pPage;
+}
+
+static b8 placeOnShelf(u16 page, u16 shelf, u32 width, u16* pPage, u16* pShelf, u32* pX, u32* pY)
+{
+	FontAtlasShelf* pShelfData = &gAtlasPages[page].shelves[shelf];
+
+	*pPage	= page;
+	*pShelf = shelf;
+	*pX		= pShelfData->cursorX;
+	*pY		= pShelfData->y;
+
+	pShelfData->cursorX += (u16)width;
+	pShelfData->lastUsedFrame = gFontFrame;
+	return SI_TRUE;
+}
+
+static b8 isGlyphOnShelf(const CachedGlyph* pGlyph, const void* pShelf)
+{
+	return pGlyph->page != GLYPH_PAGE_NONE && &gAtlasPages[pGlyph->page].shelves[pGlyph->shelf] == pShelf;
+}
+
+/**
+ * Find room for a `width` x `height` bitmap. The tightest shelf with room left wins, then a new shelf is opened on an
+ * existing or a new page, and once every page is full the least recently used shelf tall enough is evicted. Shelves
+ * used during the current frame are never evicted since their glyphs are already queued for drawing.
+ */
+static b8 allocateAtlasRegion(u32 width, u32 height, u16* pPage, u16* pShelf, u32* pX, u32* pY)
+{
+	u32 shelfHeight = (height + FONT_SHELF_GRANULARITY - 1u) / FONT_SHELF_GRANULARITY * FONT_SHELF_GRANULARITY;
+	if (width > FONT_ATLAS_PAGE_SIZE || shelfHeight > FONT_ATLAS_PAGE_SIZE)
+	{
+		return SI_FALSE;
+	}
+
+	u16 bestPage  = GLYPH_PAGE_NONE;
+	u16 bestShelf = 0u;
+	for (u16 page = 0u; page < gAtlasPageCount; ++page)
+	{
+		FontAtlasPage* pPageData = &gAtlasPages[page];
+		for (u16 shelf = 0u; shelf < pPageData->shelfCount; ++shelf)
+		{
+			FontAtlasShelf* pShelfData = &pPageData->shelves[shelf];
+			if (pShelfData->height < shelfHeight || pShelfData->height > shelfHeight + FONT_SHELF_GRANULARITY ||
+				pShelfData->cursorX + width > FONT_ATLAS_PAGE_SIZE)
+			{
+				continue;
+			}
+
+			if (bestPage == GLYPH_PAGE_NONE || pShelfData->height < gAtlasPages[bestPage].shelves[bestShelf].height)
+			{
+				bestPage  = page;
+				bestShelf = shelf;
+			}
+		}
+	}
+
+	if (bestPage != GLYPH_PAGE_NONE)
+	{
+		return placeOnShelf(bestPage, bestShelf, width, pPage, pShelf, pX, pY);
+	}
+
+	for (u16 page = 0u; page <= gAtlasPageCount && page < FONT_ATLAS_MAX_PAGES; ++page)
+	{
+		FontAtlasPage* pPageData = page < gAtlasPageCount ? &gAtlasPages[page] : createAtlasPage();
+		if (pPageData->nextShelfY + shelfHeight > FONT_ATLAS_PAGE_SIZE)
+		{
+			continue;
+		}
+
+		FontAtlasShelf* pShelfData = &pPageData->shelves[pPageData->shelfCount];
+		pShelfData->y			   = (u16)pPageData->nextShelfY;
+		pShelfData->height		   = (u16)shelfHeight;
+		pShelfData->cursorX		   = 0u;
+		pShelfData->generation	   = ++gShelfGeneration;
+		pPageData->nextShelfY += shelfHeight;
+
+		return placeOnShelf(page, (u16)pPageData->shelfCount++, width, pPage, pShelf, pX, pY);
+	}
+
+	u16 victimPage	= GLYPH_PAGE_NONE;
+	u16 victimShelf = 0u;
+	for (u16 page = 0u; page < gAtlasPageCount; ++page)
+	{
+		FontAtlasPage* pPageData = &gAtlasPages[page];
+		for (u16 shelf = 0u; shelf < pPageData->shelfCount; ++shelf)
+		{
+			FontAtlasShelf* pShelfData = &pPageData->shelves[shelf];
+			if (pShelfData->height < shelfHeight || pShelfData->lastUsedFrame == gFontFrame)
+			{
+				continue;
+			}
+
+			if (victimPage == GLYPH_PAGE_NONE ||
+				pShelfData->lastUsedFrame < gAtlasPages[victimPage].shelves[victimShelf].lastUsedFrame)
+			{
+				victimPage	= page;
+				victimShelf = shelf;
+			}
+		}
+	}
+
+	if (victimPage == GLYPH_PAGE_NONE)
+	{
+		return SI_FALSE;
+	}
+
+	FontAtlasShelf* pVictim = &gAtlasPages[victimPage].shelves[victimShelf];
+	removeGlyphs(isGlyphOnShelf, pVictim);
+	pVictim->cursorX	= 0u;
+	pVictim->generation = ++gShelfGeneration;
+
+	return placeOnShelf(victimPage, victimShelf, width, pPage, pShelf, pX, pY);
+}
+
+/**
+ * Add a shelf to the set of `siCaptureGlyphShelves`. Text looks up runs of glyphs from the same shelves, so the last
+ * added shelf is checked before the whole set.
+ */
+static void captureShelf(u16 page, u16 shelf)
+{
+	SiGlyphShelfSet* pSet = gpShelfCapture;
+	for (u32 shelfIndex = pSet->count; shelfIndex-- > 0u;)
+	{
+		if (pSet->pShelves[shelfIndex].page == page && pSet->pShelves[shelfIndex].shelf == shelf)
+		{
+			return;
+		}
+	}
+
+	if (pSet->count == pSet->capacity)
+	{
+		u32			  newCapacity = pSet->capacity > 0u ? pSet->capacity * 2u : 16u;
+		SiGlyphShelf* pNewShelves = (SiGlyphShelf*)realloc(pSet->pShelves, sizeof(SiGlyphShelf) * newCapacity);
+		if (pNewShelves == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow a glyph shelf set to %u shelves.", newCapacity);
+		}
+
+		pSet->pShelves = pNewShelves;
+		pSet->capacity = newCapacity;
+	}
+
+	SiGlyphShelf* pShelf = &pSet->pShelves[pSet->count++];
+	pShelf->page		 = page;
+	pShelf->shelf		 = shelf;
+	pShelf->generation	 = gAtlasPages[page].shelves[shelf].generation;
+}
+
+// =========================== Glyph Cache Files ===========================
+void siSetFontCacheDirectory(const char* directory)
+{
+	if (directory == SI_NULL)
+	{
+		gFontCacheDirectory[0] = '\0';
+		return;
+	}
+
+	if (strlen(directory) >= FONT_CACHE_PATH_SIZE - 32u)
+	{
+		SI_ERROR_EXIT("Font cache directory path too long: %s", directory);
+	}
+
+	siStringFormat(gFontCacheDirectory, FONT_CACHE_PATH_SIZE, "%s", directory);
+}
+
+static void getGlyphCachePath(const GlyphCacheHeader* pKey, char* path)
+{
+	u64		  hash	 = FONT_CACHE_FNV_BASIS;
+	const u8* pBytes = (const u8*)pKey;
+	for (u32 byteIndex = 0u; byteIndex < offsetof(GlyphCacheHeader, glyphCount); ++byteIndex)
+	{
+		hash ^= pBytes[byteIndex];
+		hash *= FONT_CACHE_FNV_PRIME;
+	}
+
+	siStringFormat(
+		path, FONT_CACHE_PATH_SIZE, "%s/%016llx" GLYPH_CACHE_EXTENSION, gFontCacheDirectory, (unsigned long long)hash);
+}
+
+static void openGlyphSetCache(u16 glyphSet, const FontFace* pFace, f32 scale, SiFontRasterization rasterization)
+{
+	gpGlyphSetCaches[glyphSet] = SI_NULL;
+	if (gFontCacheDirectory[0] == '\0')
+	{
+		return;
+	}
+
+	GlyphCacheHeader key = {0};
+	key.magic			 = GLYPH_CACHE_MAGIC;
+	key.version			 = GLYPH_CACHE_VERSION;
+	key.pathHash		 = pFace->pathHash;
+	key.fileSize		 = pFace->fileSize;
+	key.fileModifiedTime = pFace->fileModifiedTime;
+	key.scale			 = scale;
+	key.rasterization	 = (u32)rasterization;
+	key.oversampling	 = rasterization == SI_FONT_RASTERIZATION_SDF ? 0u : FONT_OVERSAMPLING;
+
+	// Sets of the same key rasterize the same glyphs, sharing the cache keeps a single writer of its file.
+	GlyphSetCache* pCache = SI_NULL;
+	for (u32 cacheIndex = 0u; cacheIndex < MAX_GLYPH_SETS; ++cacheIndex)
+	{
+		GlyphSetCache* pOpenCache = &gGlyphCaches[cacheIndex];
+		if (pOpenCache->refCount > 0u && memcmp(&pOpenCache->header, &key, offsetof(GlyphCacheHeader, glyphCount)) == 0)
+		{
+			pOpenCache->refCount++;
+			gpGlyphSetCaches[glyphSet] = pOpenCache;
+			return;
+		}
+
+		if (pOpenCache->refCount == 0u && pCache == SI_NULL)
+		{
+			pCache = pOpenCache;
+		}
+	}
+
+	memset(pCache, 0, sizeof(GlyphSetCache));
+	pCache->header			   = key;
+	pCache->refCount		   = 1u;
+	gpGlyphSetCaches[glyphSet] = pCache;
+
+	char path[FONT_CACHE_PATH_SIZE];
+	getGlyphCachePath(&pCache->header, path);
+	if (!siMapFile(path, &pCache->file))
+	{
+		return;
+	}
+
+	// Everything but the glyph count must match the key, the entries and bitmaps must fit into the file.
+	const GlyphCacheHeader* pHeader	  = (const GlyphCacheHeader*)pCache->file.pData;
+	u64						entrySize = 0u;
+	b8						isValid	  = pCache->file.size >= sizeof(GlyphCacheHeader) &&
+					  memcmp(pHeader, &pCache->header, offsetof(GlyphCacheHeader, glyphCount)) == 0;
+	if (isValid)
+	{
+		entrySize = (u64)pHeader->glyphCount * sizeof(GlyphCacheEntry);
+		isValid	  = sizeof(GlyphCacheHeader) + entrySize <= pCache->file.size;
+	}
+
+	const GlyphCacheEntry* pEntries = (const GlyphCacheEntry*)(pCache->file.pData + sizeof(GlyphCacheHeader));
+	for (u32 entryIndex = 0u; isValid && entryIndex < pHeader->glyphCount; ++entryIndex)
+	{
+		const GlyphCacheEntry* pEntry = &pEntries[entryIndex];
+		isValid						  = (u64)pEntry->pixelOffset + (u64)pEntry->width * pEntry->height <=
+				  pCache->file.size - sizeof(GlyphCacheHeader) - entrySize;
+	}
+
+	if (!isValid)
+	{
+		siPrintWarning("Ignoring invalid glyph cache file: %s", path);
+		siUnmapFile(&pCache->file);
+		return;
+	}
+
+	pCache->pEntries		  = pEntries;
+	pCache->pPixels			  = (const u8*)(pEntries + pHeader->glyphCount);
+	pCache->header.glyphCount = pHeader->glyphCount;
+}
+
+static const GlyphCacheEntry* findGlyphCacheEntry(u16 glyphSet, u32 codepoint)
+{
+	const GlyphSetCache* pCache = gpGlyphSetCaches[glyphSet];
+	if (pCache == SI_NULL)
+	{
+		return SI_NULL;
+	}
+
+	u32 low	 = 0u;
+	u32 high = pCache->pEntries != SI_NULL ? pCache->header.glyphCount : 0u;
+	while (low < high)
+	{
+		u32 middle = low + (high - low) / 2u;
+		if (pCache->pEntries[middle].codepoint < codepoint)
+		{
+			low = middle + 1u;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	if (pCache->pEntries == SI_NULL || low == pCache->header.glyphCount || pCache->pEntries[low].codepoint != codepoint)
+	{
+		return SI_NULL;
+	}
+
+	return &pCache->pEntries[low];
+}
+
+/**
+ * Upload the bitmap of a cached glyph into the atlas in place of rasterizing it.
+ */
+static b8 restoreCachedGlyph(u16 glyphSet, const GlyphCacheEntry* pEntry, CachedGlyph* pCachedGlyph)
+{
+	pCachedGlyph->glyph.offset = pEntry->offset;
+	pCachedGlyph->glyph.size   = pEntry->size;
+	if (pEntry->width == 0u)
+	{
+		return SI_TRUE;
+	}
+
+	u32 stride	= 0u;
+	u8* pPixels = reserveGlyphRegion(
+		pEntry->width - FONT_ATLAS_PADDING, pEntry->height - FONT_ATLAS_PADDING, pCachedGlyph, &stride);
+	if (pPixels == SI_NULL)
+	{
+		return SI_FALSE;
+	}
+
+	memcpy(pPixels, &gpGlyphSetCaches[glyphSet]->pPixels[pEntry->pixelOffset], (size_t)pEntry->width * pEntry->height);
+	return SI_TRUE;
+}
+
+/**
+ * Keep a copy of a glyph just rasterized, its padded bitmap is the last upload queued in the staging buffer.
+ */
+static void recordCachedGlyph(u16 glyphSet, const CachedGlyph* pCachedGlyph)
+{
+	GlyphSetCache* pCache = gpGlyphSetCaches[glyphSet];
+	if (pCache == SI_NULL)
+	{
+		return;
+	}
+
+	const PendingUpload* pUpload   = pCachedGlyph->page != GLYPH_PAGE_NONE ? &gpPendingUploads[gPendingUploadCount - 1u]
+																		   : SI_NULL;
+	u32					 pixelSize = pUpload != SI_NULL ? pUpload->width * pUpload->height : 0u;
+
+	if (pCache->newEntryCount == pCache->newEntryCapacity)
+	{
+		u32				 newCapacity = pCache->newEntryCapacity > 0u ? pCache->newEntryCapacity * 2u : 64u;
+		GlyphCacheEntry* pNewEntries =
+			(GlyphCacheEntry*)realloc(pCache->pNewEntries, sizeof(GlyphCacheEntry) * newCapacity);
+		if (pNewEntries == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow the glyph cache entries to %u glyphs.", newCapacity);
+		}
+
+		pCache->pNewEntries		 = pNewEntries;
+		pCache->newEntryCapacity = newCapacity;
+	}
+
+	if (pCache->newPixelSize + pixelSize > pCache->newPixelCapacity)
+	{
+		u32 newCapacity = pCache->newPixelCapacity > 0u ? pCache->newPixelCapacity : 16u * 1024u;
+		while (newCapacity < pCache->newPixelSize + pixelSize)
+		{
+			newCapacity *= 2u;
+		}
+
+		u8* pNewPixels = (u8*)realloc(pCache->pNewPixels, newCapacity);
+		if (pNewPixels == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow the glyph cache bitmaps to %u bytes.", newCapacity);
+		}
+
+		pCache->pNewPixels		 = pNewPixels;
+		pCache->newPixelCapacity = newCapacity;
+	}
+
+	GlyphCacheEntry* pEntry = &pCache->pNewEntries[pCache->newEntryCount++];
+	pEntry->codepoint		= pCachedGlyph->codepoint;
+	pEntry->width			= pUpload != SI_NULL ? (u16)pUpload->width : 0u;
+	pEntry->height			= pUpload != SI_NULL ? (u16)pUpload->height : 0u;
+	pEntry->pixelOffset		= pCache->newPixelSize;
+	pEntry->offset			= pCachedGlyph->glyph.offset;
+	pEntry->size			= pCachedGlyph->glyph.size;
+
+	if (pUpload != SI_NULL)
+	{
+		memcpy(&pCache->pNewPixels[pCache->newPixelSize], &gpStaging[pUpload->offset], pixelSize);
+		pCache->newPixelSize += pixelSize;
+	}
+}
+
+/**
+ * A glyph of the merged cache file and where its bitmap comes from.
+ */
+typedef struct MergedGlyph
+{
+	GlyphCacheEntry entry;
+	const u8*		pPixels;
+} MergedGlyph;
+
+static int compareMergedGlyphs(const void* pLeft, const void* pRight)
+{
+	u32 left  = ((const MergedGlyph*)pLeft)->entry.codepoint;
+	u32 right = ((const MergedGlyph*)pRight)->entry.codepoint;
+	return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+/**
+ * Release the cache of a glyph set. The last set of the cache merges the glyphs rasterized since it was opened into
+ * its cache file.
+ */
+static void closeGlyphSetCache(u16 glyphSet)
+{
+	GlyphSetCache* pCache	   = gpGlyphSetCaches[glyphSet];
+	gpGlyphSetCaches[glyphSet] = SI_NULL;
+	if (pCache == SI_NULL || --pCache->refCount > 0u)
+	{
+		return;
+	}
+
+	if (pCache->newEntryCount == 0u)
+	{
+		siUnmapFile(&pCache->file);
+		memset(pCache, 0, sizeof(GlyphSetCache));
+		return;
+	}
+
+	u32			 oldCount = pCache->pEntries != SI_NULL ? pCache->header.glyphCount : 0u;
+	MergedGlyph* pGlyphs  = (MergedGlyph*)malloc(sizeof(MergedGlyph) * (oldCount + pCache->newEntryCount));
+	if (pGlyphs == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate %u glyphs of the glyph cache.", oldCount + pCache->newEntryCount);
+	}
+
+	for (u32 entryIndex = 0u; entryIndex < oldCount; ++entryIndex)
+	{
+		pGlyphs[entryIndex].entry	= pCache->pEntries[entryIndex];
+		pGlyphs[entryIndex].pPixels = &pCache->pPixels[pCache->pEntries[entryIndex].pixelOffset];
+	}
+	for (u32 entryIndex = 0u; entryIndex < pCache->newEntryCount; ++entryIndex)
+	{
+		pGlyphs[oldCount + entryIndex].entry   = pCache->pNewEntries[entryIndex];
+		pGlyphs[oldCount + entryIndex].pPixels = &pCache->pNewPixels[pCache->pNewEntries[entryIndex].pixelOffset];
+	}
+
+	// Glyphs evicted from the atlas and rasterized again are recorded twice, only one of them is kept.
+	qsort(pGlyphs, oldCount + pCache->newEntryCount, sizeof(MergedGlyph), compareMergedGlyphs);
+	u32 glyphCount = 0u;
+	u64 pixelsSize = 0u;
+	for (u32 glyphIndex = 0u; glyphIndex < oldCount + pCache->newEntryCount; ++glyphIndex)
+	{
+		if (glyphCount > 0u && pGlyphs[glyphCount - 1u].entry.codepoint == pGlyphs[glyphIndex].entry.codepoint)
+		{
+			continue;
+		}
+
+		pGlyphs[glyphCount]					  = pGlyphs[glyphIndex];
+		pGlyphs[glyphCount].entry.pixelOffset = (u32)pixelsSize;
+		pixelsSize += (u64)pGlyphs[glyphIndex].entry.width * pGlyphs[glyphIndex].entry.height;
+		glyphCount++;
+	}
+
+	// The file is assembled in memory first, the mapping being replaced is still read from.
+	u64 entriesSize = sizeof(GlyphCacheEntry) * (u64)glyphCount;
+	u8* pFile		= (u8*)malloc(sizeof(GlyphCacheHeader) + entriesSize + pixelsSize);
+	if (pFile == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate a glyph cache file of %u glyphs.", glyphCount);
+	}
+
+	GlyphCacheHeader* pHeader = (GlyphCacheHeader*)pFile;
+	*pHeader				  = pCache->header;
+	pHeader->glyphCount		  = glyphCount;
+
+	GlyphCacheEntry* pEntries = (GlyphCacheEntry*)(pFile + sizeof(GlyphCacheHeader));
+	u8*				 pPixels  = pFile + sizeof(GlyphCacheHeader) + entriesSize;
+	for (u32 glyphIndex = 0u; glyphIndex < glyphCount; ++glyphIndex)
+	{
+		pEntries[glyphIndex] = pGlyphs[glyphIndex].entry;
+		memcpy(&pPixels[pEntries[glyphIndex].pixelOffset],
+			   pGlyphs[glyphIndex].pPixels,
+			   (size_t)pEntries[glyphIndex].width * pEntries[glyphIndex].height);
+	}
+
+	free(pGlyphs);
+	siUnmapFile(&pCache->file);
+
+	char path[FONT_CACHE_PATH_SIZE];
+	getGlyphCachePath(&pCache->header, path);
+
+	if (!siWriteFileAtomic(path, pFile, sizeof(GlyphCacheHeader) + entriesSize + pixelsSize, SI_NULL, 0u))
+	{
+		siPrintWarning("Failed to write glyph cache file: %s", path);
+	}
+
+	free(pFile);
+	free(pCache->pNewEntries);
+	free(pCache->pNewPixels);
+	memset(pCache, 0, sizeof(GlyphSetCache));
 }
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "simui/image.h"
+#include "simui/simui.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SIMUI_USE_STB
+#include <stb_image.h>
+
+/**
+ * Lock `gpImageMutex` for an image API call. The mutex only exists while the loader is running, so it is checked
+ * before locking; no image handle is valid before the first `siLoadImageAsync` or after `siShutdownImageLoader`.
+ */
+#define IMAGE_LOCK_AND_VALIDATE(image)                                                                                 \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if (gpImageMutex == SI_NULL || image >= SI_MAX_ASYNC_IMAGES)                                                   \
+		{                                                                                                              \
+			SI_ERROR_EXIT("Invalid image handle.");                                                                    \
+		}                                                                                                              \
+                                                                                                                       \
+		siLockMutex(gpImageMutex);                                                                                     \
+		if (gImages[image].state == IMAGE_STATE_FREE || gImages[image].isCancelled)                                    \
+		{                                                                                                              \
+			SI_ERROR_EXIT("Image handle not in use.");                                                                 \
+		}                                                                                                              \
+	} while (0)
+
+typedef enum ImageState
+{
+	IMAGE_STATE_FREE,	  ///< The slot is not used.
+	IMAGE_STATE_QUEUED,	  ///< Waiting in the queue for a worker.
+	IMAGE_STATE_DECODING, ///< Being decoded by a worker.
+	IMAGE_STATE_DECODED,  ///< Decoded, waiting for `siUploadLoadedImages`.
+	IMAGE_STATE_READY,	  ///< Uploaded into `texture`.
+	IMAGE_STATE_FAILED,	  ///< The file could not be read or decoded.
+} ImageState;
+
+typedef struct AsyncImage
+{
+	ImageState state;		///< Where the image is in its loading.
+	b8		   isCancelled; ///< Released while a worker still references the slot, the worker frees it.
+	char*	   filePath;	///< Copy of the path of the file, until it is decoded.
+	u8*		   pPixels;		///< The decoded RGBA8 pixels, until they are uploaded.
+	u32		   width;		///< The width of the decoded image.
+	u32		   height;		///< The height of the decoded image.
+	SiTexture  texture;		///< The texture of the ready image.
+} AsyncImage;
+
+/**
+ * Every field of the images and of the queue is guarded by `gpImageMutex`. Workers only hold it to pick a job and to
+ * publish its result, the decoding itself runs unlocked.
+ */
+static AsyncImage	gImages[SI_MAX_ASYNC_IMAGES];
+static u32			gImageQueue[SI_MAX_ASYNC_IMAGES]; ///< Ring buffer of the slots waiting for a worker.
+static u32			gImageQueueHead	   = 0u;
+static u32			gImageQueueCount   = 0u;
+static SiThread*	gpImageWorkers[SI_IMAGE_LOADER_THREADS];
+static u32			gImageWorkerCount  = 0u;
+static SiMutex*		gpImageMutex	   = SI_NULL;
+static SiCondition* gpImageCondition   = SI_NULL;
+static b8			gShouldStopWorkers = SI_FALSE;
+
+static void releaseImageSlot(AsyncImage* pImage)
+{
+	free(pImage->filePath);
+	stbi_image_free(pImage->pPixels);
+	memset(pImage, 0, sizeof(AsyncImage));
+}
+
+static void runImageWorker(void* pArgument)
+{
+	(void)pArgument;
+
+	siLockMutex(gpImageMutex);
+	while (SI_TRUE)
+	{
+		while (gImageQueueCount == 0u && !gShouldStopWorkers)
+		{
+			siWaitCondition(gpImageCondition, gpImageMutex);
+		}
+
+		if (gShouldStopWorkers)
+		{
+			break;
+		}
+
+		AsyncImage* pImage = &gImages[gImageQueue[gImageQueueHead]];
+		gImageQueueHead	   = (gImageQueueHead + 1u) % SI_MAX_ASYNC_IMAGES;
+		gImageQueueCount--;
+
+		if (pImage->isCancelled)
+		{
+			releaseImageSlot(pImage);
+			continue;
+		}
+
+		pImage->state	 = IMAGE_STATE_DECODING;
+		char* filePath	 = pImage->filePath;
+		pImage->filePath = SI_NULL;
+		siUnlockMutex(gpImageMutex);
+
+		// stbi_load leaves the size untouched when it fails.
+		int width = 0, height = 0, channels = 0;
+		u8* pPixels = stbi_load(filePath, &width, &height, &channels, 4);
+		free(filePath);
+
+		siLockMutex(gpImageMutex);
+		pImage->pPixels = pPixels;
+		pImage->width	= (u32)width;
+		pImage->height	= (u32)height;
+		pImage->state	= pPixels != SI_NULL ? IMAGE_STATE_DECODED : IMAGE_STATE_FAILED;
+
+		if (pImage->isCancelled)
+		{
+			releaseImageSlot(pImage);
+		}
+	}
+	siUnlockMutex(gpImageMutex);
+}
+
+static void startImageWorkers()
+{
+	gpImageMutex	   = siCreateMutex();
+	gpImageCondition   = siCreateCondition();
+	gShouldStopWorkers = SI_FALSE;
+
+	for (gImageWorkerCount = 0u; gImageWorkerCount < SI_IMAGE_LOADER_THREADS; ++gImageWorkerCount)
+	{
+		gpImageWorkers[gImageWorkerCount] = siCreateThread(runImageWorker, SI_NULL);
+	}
+}
+
+SiImage siLoadImageAsync(const char* filePath)
+{
+	if (gImageWorkerCount == 0u)
+	{
+		startImageWorkers();
+	}
+
+	siLockMutex(gpImageMutex);
+
+	SiImage image = 0u;
+	for (image = 0u; image < SI_MAX_ASYNC_IMAGES; ++image)
+	{
+		if (gImages[image].state == IMAGE_STATE_FREE)
+		{
+			break;
+		}
+	}
+
+	if (image == SI_MAX_ASYNC_IMAGES)
+	{
+		SI_ERROR_EXIT("Too many images loaded, failed to load: %s", filePath);
+	}
+
+	AsyncImage* pImage = &gImages[image];
+	pImage->filePath   = (char*)malloc(strlen(filePath) + 1u);
+	if (pImage->filePath == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to copy the image path: %s", filePath);
+	}
+	strcpy(pImage->filePath, filePath);
+	pImage->state	= IMAGE_STATE_QUEUED;
+	pImage->texture = SI_TEXTURE_NULL;
+
+	gImageQueue[(gImageQueueHead + gImageQueueCount++) % SI_MAX_ASYNC_IMAGES] = image;
+	siBroadcastCondition(gpImageCondition);
+
+	siUnlockMutex(gpImageMutex);
+	return image;
+}
+
+SiImageStatus siGetImageStatus(SiImage image)
+{
+	IMAGE_LOCK_AND_VALIDATE(image);
+
+	SiImageStatus status = SI_IMAGE_STATUS_LOADING;
+	if (gImages[image].state == IMAGE_STATE_READY)
+	{
+		status = SI_IMAGE_STATUS_READY;
+	}
+	else if (gImages[image].state == IMAGE_STATE_FAILED)
+	{
+		status = SI_IMAGE_STATUS_FAILED;
+	}
+
+	siUnlockMutex(gpImageMutex);
+	return status;
+}
+
+SiSprite siGetImageSprite(SiImage image)
+{
+	IMAGE_LOCK_AND_VALIDATE(image);
+
+	SiSprite sprite = {0};
+	sprite.texture	= gImages[image].state == IMAGE_STATE_READY ? gImages[image].texture : SI_TEXTURE_NULL;
+	sprite.quadMin	= (SiVector2){0.0f, 0.0f};
+	sprite.quadMax	= (SiVector2){1.0f, 1.0f};
+
+	siUnlockMutex(gpImageMutex);
+	return sprite;
+}
+
+void siCancelImage(SiImage image)
+{
+	IMAGE_LOCK_AND_VALIDATE(image);
+
+	AsyncImage* pImage	= &gImages[image];
+	SiTexture	texture = pImage->state == IMAGE_STATE_READY ? pImage->texture : SI_TEXTURE_NULL;
+
+	// A worker still references queued and decoding images, it releases them once done.
+	if (pImage->state == IMAGE_STATE_QUEUED || pImage->state == IMAGE_STATE_DECODING)
+	{
+		pImage->isCancelled = SI_TRUE;
+	}
+	else
+	{
+		releaseImageSlot(pImage);
+	}
+
+	siUnlockMutex(gpImageMutex);
+
+	if (texture != SI_TEXTURE_NULL)
+	{
+		siDestroyTexture(texture);
+	}
+}
+
+void siUploadLoadedImages(f64 budgetSeconds)
+{
+	if (gImageWorkerCount == 0u)
+	{
+		return;
+	}
+
+	f64 startTime	= siGetTime();
+	u32 uploadCount = 0u;
+
+	siLockMutex(gpImageMutex);
+	for (u32 image = 0u; image < SI_MAX_ASYNC_IMAGES; ++image)
+	{
+		AsyncImage* pImage = &gImages[image];
+		if (pImage->state != IMAGE_STATE_DECODED)
+		{
+			continue;
+		}
+
+		if (uploadCount > 0u && siGetTime() - startTime >= budgetSeconds)
+		{
+			break;
+		}
+
+		pImage->texture = siCreateTexture(pImage->width, pImage->height, SI_TEXTURE_FORMAT_RGBA8, pImage->pPixels);
+		pImage->state	= IMAGE_STATE_READY;
+		stbi_image_free(pImage->pPixels);
+		pImage->pPixels = SI_NULL;
+		uploadCount++;
+	}
+	siUnlockMutex(gpImageMutex);
+}
+
+void siShutdownImageLoader()
+{
+	if (gImageWorkerCount == 0u)
+	{
+		return;
+	}
+
+	siLockMutex(gpImageMutex);
+	gShouldStopWorkers = SI_TRUE;
+	siBroadcastCondition(gpImageCondition);
+	siUnlockMutex(gpImageMutex);
+
+	for (u32 workerIndex = 0u; workerIndex < gImageWorkerCount; ++workerIndex)
+	{
+		siJoinThread(gpImageWorkers[workerIndex]);
+	}
+
+	for (u32 image = 0u; image < SI_MAX_ASYNC_IMAGES; ++image)
+	{
+		if (gImages[image].state == IMAGE_STATE_READY)
+		{
+			siDestroyTexture(gImages[image].texture);
+		}
+		releaseImageSlot(&gImages[image]);
+	}
+
+	siDestroyCondition(gpImageCondition);
+	siDestroyMutex(gpImageMutex);
+	gpImageCondition  = SI_NULL;
+	gpImageMutex	  = SI_NULL;
+	gImageQueueHead	  = 0u;
+	gImageQueueCount  = 0u;
+	gImageWorkerCount = 0u;
+}
+#endif // SIMUI_USE_STB
\ No newline at end of file
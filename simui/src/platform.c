@@ -4,6 +4,51 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef _WIN32
+#include <windows.h>
+
+struct SiMutex
+{
+	SRWLOCK lock;
+};
+
+struct SiCondition
+{
+	CONDITION_VARIABLE condition;
+};
+
+struct SiThread
+{
+	HANDLE				 handle;
+	FPN_SiThreadFunction function;
+	void*				 pArgument;
+};
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+struct SiMutex
+{
+	pthread_mutex_t mutex;
+};
+
+struct SiCondition
+{
+	pthread_cond_t condition;
+};
+
+struct SiThread
+{
+	pthread_t			 thread;
+	FPN_SiThreadFunction function;
+	void*				 pArgument;
+};
+#endif // _WIN32
+
 void siStringFormat(char* buffer, u32 bufferSize, const char* format, ...)
 {
 	va_list args;
@@ -50,20 +95,21 @@ void siPrintWarning(const char* message, ...)
 
 u32 readFile(const char* filePath, char* buffer, u32 bufferSize)
 {
-	FILE* file = fopen(filePath, "r");
+	FILE* file = fopen(filePath, "rb");
 	if (!file)
 	{
-		SI_ERROR_EXIT("Failed to open shader file: %s", filePath);
+		SI_ERROR_EXIT("Failed to open file: %s", filePath);
 	}
 
 	memset(buffer, 0, bufferSize);
 
-	u32 fileLength = fseek(file, 0, SEEK_END);
+	// `fseek` only reports success, the length is the position it moved to.
+	long fileLength = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1L;
 	rewind(file);
 
-	if (fileLength >= bufferSize)
+	if (fileLength < 0L || (u64)fileLength >= bufferSize)
 	{
-		SI_ERROR_EXIT("Shader file too large: %s", filePath);
+		SI_ERROR_EXIT("File too large for a buffer of %u bytes: %s", bufferSize, filePath);
 	}
 
 	size_t bytesRead  = fread(buffer, 1, bufferSize - 1, file);
@@ -74,6 +120,168 @@ u32 readFile(const char* filePath, char* buffer, u32 bufferSize)
 	return (u32)bytesRead;
 }
 
+b8 siMapFile(const char* filePath, SiMappedFile* pFile)
+{
+	memset(pFile, 0, sizeof(SiMappedFile));
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(
+		filePath, GENERIC_READ, FILE_SHARE_READ, SI_NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, SI_NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return SI_FALSE;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return SI_FALSE;
+	}
+
+	// The mapping object keeps the file open, its handle is not needed anymore.
+	HANDLE mapping = CreateFileMappingA(file, SI_NULL, PAGE_READONLY, 0, 0, SI_NULL);
+	CloseHandle(file);
+	if (mapping == SI_NULL)
+	{
+		return SI_FALSE;
+	}
+
+	void* pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (pData == SI_NULL)
+	{
+		CloseHandle(mapping);
+		return SI_FALSE;
+	}
+
+	pFile->pHandle = mapping;
+	pFile->size	   = (u64)size.QuadPart;
+#else
+	int file = open(filePath, O_RDONLY);
+	if (file < 0)
+	{
+		return SI_FALSE;
+	}
+
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size == 0)
+	{
+		close(file);
+		return SI_FALSE;
+	}
+
+	// The mapping keeps a reference to the file, the descriptor is not needed anymore.
+	void* pData = mmap(SI_NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (pData == MAP_FAILED)
+	{
+		return SI_FALSE;
+	}
+
+	pFile->size = (u64)status.st_size;
+#endif // _WIN32
+
+	pFile->pData = (const u8*)pData;
+	return SI_TRUE;
+}
+
+void siUnmapFile(SiMappedFile* pFile)
+{
+	if (pFile->pData == SI_NULL)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(pFile->pData);
+	CloseHandle((HANDLE)pFile->pHandle);
+#else
+	munmap((void*)pFile->pData, (size_t)pFile->size);
+#endif // _WIN32
+
+	memset(pFile, 0, sizeof(SiMappedFile));
+}
+
+b8 siGetFileInfo(const char* filePath, u64* pSize, u64* pModifiedTime)
+{
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (!GetFileAttributesExA(filePath, GetFileExInfoStandard, &attributes))
+	{
+		return SI_FALSE;
+	}
+
+	*pSize		   = ((u64)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+	*pModifiedTime = ((u64)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+#else
+	struct stat status;
+	if (stat(filePath, &status) != 0)
+	{
+		return SI_FALSE;
+	}
+
+	*pSize		   = (u64)status.st_size;
+	*pModifiedTime = (u64)status.st_mtime;
+#endif // _WIN32
+
+	return SI_TRUE;
+}
+
+b8 siWriteFileAtomic(const char* filePath, const void* pHeader, u64 headerSize, const void* pData, u64 dataSize)
+{
+	u32	  tempPathSize = (u32)strlen(filePath) + 32u;
+	char* tempPath	   = (char*)malloc(tempPathSize);
+	if (tempPath == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate the temporary path of: %s", filePath);
+	}
+
+	// The temporary file is unique to the writer, two writers of the same file never write into each other.
+#ifdef _WIN32
+	siStringFormat(tempPath, tempPathSize, "%s.%lu.%lu.tmp", filePath, GetCurrentProcessId(), GetCurrentThreadId());
+	FILE* file = fopen(tempPath, "wb");
+#else
+	siStringFormat(tempPath, tempPathSize, "%s.XXXXXX", filePath);
+	int	  descriptor = mkstemp(tempPath);
+	FILE* file		 = descriptor >= 0 ? fdopen(descriptor, "wb") : SI_NULL;
+	if (descriptor >= 0 && file == SI_NULL)
+	{
+		close(descriptor);
+		remove(tempPath);
+	}
+
+	// `mkstemp` creates the file for its owner only, the replaced file is readable like the ones `fopen` creates.
+	if (file != SI_NULL)
+	{
+		fchmod(descriptor, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	}
+#endif // _WIN32
+
+	if (file == SI_NULL)
+	{
+		free(tempPath);
+		return SI_FALSE;
+	}
+
+	b8 isWritten = (headerSize == 0u || fwrite(pHeader, 1, (size_t)headerSize, file) == (size_t)headerSize) &&
+				   (dataSize == 0u || fwrite(pData, 1, (size_t)dataSize, file) == (size_t)dataSize);
+	isWritten	 = fclose(file) == 0 && isWritten;
+
+#ifdef _WIN32
+	isWritten = isWritten && MoveFileExA(tempPath, filePath, MOVEFILE_REPLACE_EXISTING);
+#else
+	isWritten = isWritten && rename(tempPath, filePath) == 0;
+#endif // _WIN32
+
+	if (!isWritten)
+	{
+		remove(tempPath);
+	}
+
+	free(tempPath);
+	return isWritten;
+}
+
 b8 isBigEndian()
 {
 	u16 testValue = 0x1;
@@ -98,4 +306,171 @@ u32 siU32LittleToBigEndian(u32 value)
 u16 siU16LittleToBigEndian(u16 value)
 {
 	return (u16)(((value & 0x00FFU) << 8) | ((value & 0xFF00U) >> 8));
+}
+
+SiMutex* siCreateMutex()
+{
+	SiMutex* pMutex = (SiMutex*)malloc(sizeof(SiMutex));
+	if (pMutex == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate a mutex.");
+	}
+
+#ifdef _WIN32
+	InitializeSRWLock(&pMutex->lock);
+#else
+	if (pthread_mutex_init(&pMutex->mutex, SI_NULL) != 0)
+	{
+		SI_ERROR_EXIT("Failed to initialize a mutex.");
+	}
+#endif // _WIN32
+
+	return pMutex;
+}
+
+void siLockMutex(SiMutex* pMutex)
+{
+#ifdef _WIN32
+	AcquireSRWLockExclusive(&pMutex->lock);
+#else
+	pthread_mutex_lock(&pMutex->mutex);
+#endif // _WIN32
+}
+
+void siUnlockMutex(SiMutex* pMutex)
+{
+#ifdef _WIN32
+	ReleaseSRWLockExclusive(&pMutex->lock);
+#else
+	pthread_mutex_unlock(&pMutex->mutex);
+#endif // _WIN32
+}
+
+void siDestroyMutex(SiMutex* pMutex)
+{
+#ifndef _WIN32
+	pthread_mutex_destroy(&pMutex->mutex);
+#endif // _WIN32
+
+	free(pMutex);
+}
+
+SiCondition* siCreateCondition()
+{
+	SiCondition* pCondition = (SiCondition*)malloc(sizeof(SiCondition));
+	if (pCondition == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate a condition variable.");
+	}
+
+#ifdef _WIN32
+	InitializeConditionVariable(&pCondition->condition);
+#else
+	if (pthread_cond_init(&pCondition->condition, SI_NULL) != 0)
+	{
+		SI_ERROR_EXIT("Failed to initialize a condition variable.");
+	}
+#endif // _WIN32
+
+	return pCondition;
+}
+
+void siWaitCondition(SiCondition* pCondition, SiMutex* pMutex)
+{
+#ifdef _WIN32
+	SleepConditionVariableSRW(&pCondition->condition, &pMutex->lock, INFINITE, 0);
+#else
+	pthread_cond_wait(&pCondition->condition, &pMutex->mutex);
+#endif // _WIN32
+}
+
+void siBroadcastCondition(SiCondition* pCondition)
+{
+#ifdef _WIN32
+	WakeAllConditionVariable(&pCondition->condition);
+#else
+	pthread_cond_broadcast(&pCondition->condition);
+#endif // _WIN32
+}
+
+void siDestroyCondition(SiCondition* pCondition)
+{
+#ifndef _WIN32
+	pthread_cond_destroy(&pCondition->condition);
+#endif // _WIN32
+
+	free(pCondition);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI runThread(LPVOID pParameter)
+#else
+static void* runThread(void* pParameter)
+#endif // _WIN32
+{
+	SiThread* pThread = (SiThread*)pParameter;
+	pThread->function(pThread->pArgument);
+	return 0;
+}
+
+SiThread* siCreateThread(FPN_SiThreadFunction function, void* pArgument)
+{
+	SiThread* pThread = (SiThread*)malloc(sizeof(SiThread));
+	if (pThread == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate a thread.");
+	}
+
+	pThread->function  = function;
+	pThread->pArgument = pArgument;
+
+#ifdef _WIN32
+	pThread->handle = CreateThread(SI_NULL, 0, runThread, pThread, 0, SI_NULL);
+	if (pThread->handle == SI_NULL)
+#else
+	if (pthread_create(&pThread->thread, SI_NULL, runThread, pThread) != 0)
+#endif // _WIN32
+	{
+		SI_ERROR_EXIT("Failed to create a thread.");
+	}
+
+	return pThread;
+}
+
+void siJoinThread(SiThread* pThread)
+{
+#ifdef _WIN32
+	WaitForSingleObject(pThread->handle, INFINITE);
+	CloseHandle(pThread->handle);
+#else
+	pthread_join(pThread->thread, SI_NULL);
+#endif // _WIN32
+
+	free(pThread);
+}
+
+void siSleep(f64 seconds)
+{
+#ifdef _WIN32
+	Sleep((DWORD)(seconds * 1000.0));
+#else
+	struct timespec duration = {0};
+	duration.tv_sec			 = (time_t)seconds;
+	duration.tv_nsec		 = (long)((seconds - (f64)duration.tv_sec) * 1000000000.0);
+	nanosleep(&duration, SI_NULL);
+#endif // _WIN32
+}
+
+f64 siGetTime()
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (f64)counter.QuadPart / (f64)frequency.QuadPart;
+#else
+	struct timespec now = {0};
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (f64)now.tv_sec + (f64)now.tv_nsec / 1000000000.0;
+#endif // _WIN32
 }
\ No newline at end of file
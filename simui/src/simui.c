@@ -1,29 +1,1094 @@
 #include "simui/simui.h"
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
 
 #ifdef SIMUI_USE_STB
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #endif // SIMUI_USE_STB
 
-#define DRAWING_EVENT_BUFFER_SIZE 1024
-#define CHECK_DRAWING_EVENT_BUFFER_CAPACITY()                                                                          \
-	if (gDrawingEventsCount >= DRAWING_EVENT_BUFFER_SIZE)                                                              \
+#define DRAWING_EVENT_BLOCK_SIZE 256
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ull
+#define FNV_PRIME		 0x100000001b3ull
+
+#define INITIAL_PRIMITIVE_CAPACITY 256u
+
+/**
+ * Fixed-size block of drawing events, allocated from the frame arena. The blocks of a frame form a linked list in
+ * recording order.
+ */
+typedef struct SiUIEventBlock
+{
+	SiUIEvent			   events[DRAWING_EVENT_BLOCK_SIZE]; ///< The events stored in this block.
+	u32					   count;							 ///< Number of events used in this block.
+	struct SiUIEventBlock* pNext;							 ///< The next block of the frame.
+} SiUIEventBlock;
+
+/**
+ * Bookkeeping of a draw list on the library side, the geometry itself is owned by the rendering backend.
+ */
+typedef struct SiDrawListData
+{
+	b8				isUsed;			  ///< Flag to indicate if the draw list slot is used.
+	b8				isRecorded;		  ///< Whether the list was recorded and not invalidated since.
+	b8				hasEvictedGlyphs; ///< Whether a shelf of `glyphShelves` was evicted, see `updateDrawListGlyphs`.
+	SiGlyphShelfSet glyphShelves;	  ///< The glyph atlas shelves the recorded text samples, touched on every replay.
+	u32				recordSerial;	  ///< Unique number of the last recording, part of the frame hash of a replay.
+	SiVector4		bounds;			  ///< Union of the bounds of the recorded primitives, before the replay offset.
+} SiDrawListData;
+
+/**
+ * What the dirty region diff remembers of a drawing event between two frames.
+ */
+typedef struct SiPrimitive
+{
+	u64		  hash;	  ///< Hash of the event parameters, see `hashDrawingEvent`.
+	SiVector4 bounds; ///< The area covered by the event: left, bottom, right and top in drawing coordinates.
+} SiPrimitive;
+
+/**
+ * Random access to the events of the frame and their bounds, built in the frame arena for the passes which drop or
+ * reorder events before they are dispatched.
+ */
+typedef struct SiFrameEvents
+{
+	const SiUIEvent** ppEvents; ///< The events of the frame, in recording order.
+	SiVector4*		  pBounds;	///< The bounds of every event, see `getDrawingEventBounds`.
+	u32				  count;	///< The number of events.
+} SiFrameEvents;
+
+/**
+ * Consecutive events of the batching reorder which share a material, chained through their event indices.
+ */
+typedef struct SiEventGroup
+{
+	u64		  materialKey; ///< See `getMaterialKey`.
+	SiVector4 bounds;	   ///< Union of the bounds of the events of the group.
+	u32		  firstEvent;  ///< Index of the first event of the group.
+	u32		  lastEvent;   ///< Index of the last event of the group.
+} SiEventGroup;
+
+/**
+ * The command buffer of one `siBeginThreadRecording`/`siEndThreadRecording` pair. Each recording has an arena of its
+ * own, so threads never share memory while recording.
+ */
+typedef struct SiThreadRecording
+{
+	SiArena			arena;			 ///< Memory of the recorded events and their text, kept for the following frames.
+	SiUIEventBlock* pFirstBlock;	 ///< The first block of recorded events.
+	SiUIEventBlock* pLastBlock;		 ///< The block events are currently appended to.
+	u32				eventCount;		 ///< Number of recorded events.
+	u32				sortKey;		 ///< The key the recordings are merged by, in ascending order.
+	u32				submissionIndex; ///< The order of `siEndThreadRecording` calls, breaks ties between equal keys.
+	b8				isUsed;			 ///< Whether the slot holds a recording not rendered yet.
+	b8				isSubmitted;	 ///< Whether `siEndThreadRecording` was called for the recording.
+	b8				isMerged;		 ///< Whether the recording was merged into the frame being rendered.
+} SiThreadRecording;
+
+/**
+ * Everything needed to render a frame, decided by `siRender` on the recording thread. With the render thread, the
+ * frame is handed over and rendered while the next one is recorded.
+ */
+typedef struct SiRenderFrame
+{
+	SiUIEventBlock* pFirstBlock;	///< The events of the frame, in recording order.
+	SiVector2		windowSize;		///< The window size the frame was recorded with.
+	SiVector4		dirtyRegion;	///< The region to redraw, see `FPN_SiSetDirtyRegion`.
+	b8				isUnchanged;	///< Whether the frame is skipped, see `FPN_SiSkipFrame`.
+	b8				isPartial;		///< Whether only the events overlapping `dirtyRegion` are dispatched.
+	b8				hasDirtyRegion; ///< Whether `dirtyRegion` is handed to the backend.
+	const u8*		pCulled;		///< One flag per event, set for the events not to dispatch, or `SI_NULL`.
+
+	const SiUIEvent** ppEvents;	  ///< The events of the frame in recording order, when `pOrder` is set.
+	const u32*		  pOrder;	  ///< Indices of the events to dispatch in dispatch order, or `SI_NULL`.
+	u32				  orderCount; ///< The number of indices in `pOrder`.
+} SiRenderFrame;
+
+#define DRAW_LIST_VALIDATE(drawList)                                                                                   \
+	do                                                                                                                 \
 	{                                                                                                                  \
-		return;                                                                                                        \
+		if (drawList >= SI_MAX_DRAW_LISTS)                                                                             \
+		{                                                                                                              \
+			SI_ERROR_EXIT("Invalid draw list handle.");                                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		if (!gDrawLists[drawList].isUsed)                                                                              \
+		{                                                                                                              \
+			SI_ERROR_EXIT("Draw list handle not in use.");                                                             \
+		}                                                                                                              \
+	} while (0)
+
+SiCallbackHub gSiCallbackHub = {0};
+SiContext	  gSiContext	 = {0};
+
+static SiUIEventBlock* gpFirstDrawingEventBlock = SI_NULL;
+static SiUIEventBlock* gpLastDrawingEventBlock	= SI_NULL;
+static u32			   gDrawingEventsCount		= 0u;
+static SiFrameStats	   gFrameStats				= {0};
+
+static SiDrawListData  gDrawLists[SI_MAX_DRAW_LISTS];
+static SiDrawList	   gRecordingDrawList		 = SI_DRAW_LIST_NULL;
+static SiUIEventBlock* gpFirstRecordedEventBlock = SI_NULL;
+static SiUIEventBlock* gpLastRecordedEventBlock	 = SI_NULL;
+static u32			   gDrawListRecordSerial	 = 0u;
+
+static b8  gSkipUnchangedFrames = SI_FALSE;
+static b8  gIsFrameDirty		= SI_TRUE;
+static u64 gLastFrameHash		= 0u;
+
+static SiThreadRecording gThreadRecordings[SI_MAX_THREAD_RECORDINGS];
+static SiMutex*			 gpThreadRecordingMutex	   = SI_NULL;
+static u32				 gThreadSubmissionCount	   = 0u;
+static u64				 gThreadRecordingArenaSize = SI_DEFAULT_FRAME_ARENA_SIZE;
+
+static SI_THREAD_LOCAL SiThreadRecording* gpThreadRecording = SI_NULL; ///< The recording of the calling thread.
+
+static SiThread*	 gpRenderThread			 = SI_NULL;
+static SiMutex*		 gpRenderMutex			 = SI_NULL;
+static SiCondition*	 gpRenderCondition		 = SI_NULL;
+static SiRenderFrame gRenderFrame			 = {0};
+static SiArena		 gRenderFrameArena		 = {0};
+static b8			 gIsFramePending		 = SI_FALSE;
+static b8			 gIsContextRequested	 = SI_FALSE;
+static b8			 gIsContextReleased		 = SI_FALSE;
+static b8			 gShouldStopRenderThread = SI_FALSE;
+
+static SI_THREAD_LOCAL b8 gIsRenderThread = SI_FALSE; ///< Set on the render thread, which owns the context already.
+
+/**
+ * Nesting of `siAcquireRenderContext` on the calling thread, so that loader threads creating textures do not count
+ * against the application thread.
+ */
+static SI_THREAD_LOCAL u32 gRenderContextDepth = 0u;
+
+static b8			gRedrawDirtyRegions			= SI_FALSE;
+static b8			gCullHiddenPrimitives		= SI_FALSE;
+static b8			gReorderForBatching			= SI_FALSE;
+static f64			gImageUploadBudget			= SI_DEFAULT_IMAGE_UPLOAD_BUDGET;
+static SiVector2	gPreviousWindowSize			= {0};
+static SiPrimitive* gpPrimitives				= SI_NULL; ///< The primitives of the frame being rendered.
+static u32			gPrimitiveCount				= 0u;
+static u32			gPrimitiveCapacity			= 0u;
+static SiPrimitive* gpPreviousPrimitives		= SI_NULL; ///< The primitives of the last rendered frame.
+static u32			gPreviousPrimitiveCount		= 0u;
+static u32			gPreviousPrimitiveCapacity	= 0u;
+
+#define EMPTY_BOUNDS ((SiVector4){FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX})
+#define FULL_REGION	 ((SiVector4){-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX})
+
+#define MAX_OCCLUDERS		 8u
+#define MAX_REORDER_LOOKBACK 32u
+#define MATERIAL_KEY_NONE	 ((u64) - 1)
+#define EVENT_INDEX_NONE	 ((u32) - 1)
+
+/**
+ * The arena holding the events recorded by the calling thread: the arena of its thread recording, if any, or else the
+ * frame arena.
+ */
+static SiArena* getRecordingArena()
+{
+	return gpThreadRecording != SI_NULL ? &gpThreadRecording->arena : &gSiContext.frameArena;
+}
+
+/**
+ * Append a new event to the frame's event queue, to the thread recording of the calling thread, or to the recorded
+ * draw list between `siBeginDrawList` and `siEndDrawList`. The memory comes from an arena, so the queue grows without
+ * per-event allocations and is released all at once after `siRender`.
+ */
+static SiUIEvent* pushDrawingEvent()
+{
+	SiUIEventBlock** ppFirstBlock = &gpFirstDrawingEventBlock;
+	SiUIEventBlock** ppLastBlock  = &gpLastDrawingEventBlock;
+	u32*			 pEventCount  = &gDrawingEventsCount;
+
+	if (gpThreadRecording != SI_NULL)
+	{
+		ppFirstBlock = &gpThreadRecording->pFirstBlock;
+		ppLastBlock	 = &gpThreadRecording->pLastBlock;
+		pEventCount	 = &gpThreadRecording->eventCount;
+	}
+	else if (gRecordingDrawList != SI_DRAW_LIST_NULL)
+	{
+		ppFirstBlock = &gpFirstRecordedEventBlock;
+		ppLastBlock	 = &gpLastRecordedEventBlock;
+		pEventCount	 = SI_NULL;
+	}
+
+	if (*ppLastBlock == SI_NULL || (*ppLastBlock)->count == DRAWING_EVENT_BLOCK_SIZE)
+	{
+		SiUIEventBlock* pBlock = (SiUIEventBlock*)siArenaAllocate(
+			getRecordingArena(), sizeof(SiUIEventBlock), _Alignof(SiUIEventBlock));
+		pBlock->count = 0u;
+		pBlock->pNext = SI_NULL;
+
+		if (*ppLastBlock == SI_NULL)
+		{
+			*ppFirstBlock = pBlock;
+		}
+		else
+		{
+			(*ppLastBlock)->pNext = pBlock;
+		}
+		*ppLastBlock = pBlock;
+	}
+
+	if (pEventCount != SI_NULL)
+	{
+		(*pEventCount)++;
+	}
+
+	return &(*ppLastBlock)->events[(*ppLastBlock)->count++];
+}
+
+static b8 isRecordingMergedBefore(const SiThreadRecording* pFirst, const SiThreadRecording* pSecond)
+{
+	if (pFirst->sortKey != pSecond->sortKey)
+	{
+		return pFirst->sortKey < pSecond->sortKey;
+	}
+
+	return pFirst->submissionIndex < pSecond->submissionIndex;
+}
+
+/**
+ * Append the submitted thread recordings to the frame's events, by ascending sort key and then submission order. Only
+ * the block lists are linked, the events stay in the arenas of the recordings until `releaseFrameMemory`. Recordings
+ * still in progress are left for the next frame.
+ */
+static void mergeThreadRecordings()
+{
+	SiThreadRecording* pMerged[SI_MAX_THREAD_RECORDINGS];
+	u32				   mergedCount = 0u;
+
+	siLockMutex(gpThreadRecordingMutex);
+	for (u32 recordingIndex = 0u; recordingIndex < SI_MAX_THREAD_RECORDINGS; ++recordingIndex)
+	{
+		SiThreadRecording* pRecording = &gThreadRecordings[recordingIndex];
+		if (!pRecording->isUsed || !pRecording->isSubmitted)
+		{
+			continue;
+		}
+
+		pRecording->isMerged = SI_TRUE;
+
+		// Insertion sort, there are only a handful of recordings per frame.
+		u32 position = mergedCount++;
+		while (position > 0u && isRecordingMergedBefore(pRecording, pMerged[position - 1u]))
+		{
+			pMerged[position] = pMerged[position - 1u];
+			position--;
+		}
+		pMerged[position] = pRecording;
+	}
+	siUnlockMutex(gpThreadRecordingMutex);
+
+	for (u32 mergedIndex = 0u; mergedIndex < mergedCount; ++mergedIndex)
+	{
+		SiThreadRecording* pRecording = pMerged[mergedIndex];
+		if (pRecording->pFirstBlock == SI_NULL)
+		{
+			continue;
+		}
+
+		if (gpLastDrawingEventBlock == SI_NULL)
+		{
+			gpFirstDrawingEventBlock = pRecording->pFirstBlock;
+		}
+		else
+		{
+			gpLastDrawingEventBlock->pNext = pRecording->pFirstBlock;
+		}
+
+		gpLastDrawingEventBlock = pRecording->pLastBlock;
+		gDrawingEventsCount += pRecording->eventCount;
+	}
+}
+
+static b8 doBoundsOverlap(SiVector4 first, SiVector4 second)
+{
+	return first.x < second.z && second.x < first.z && first.y < second.w && second.y < first.w;
+}
+
+static SiVector4 unionBounds(SiVector4 first, SiVector4 second)
+{
+	SiVector4 bounds = {};
+	bounds.x		 = first.x < second.x ? first.x : second.x;
+	bounds.y		 = first.y < second.y ? first.y : second.y;
+	bounds.z		 = first.z > second.z ? first.z : second.z;
+	bounds.w		 = first.w > second.w ? first.w : second.w;
+	return bounds;
+}
+
+static void dispatchDrawingEvent(const SiUIEvent* pEvent)
+{
+	switch (pEvent->type)
+	{
+	case SI_UI_EVENT_TYPE_DRAW_RECTANGLE:
+		if (gSiCallbackHub.drawRectangleFunction)
+		{
+			gSiCallbackHub.drawRectangleFunction(pEvent->drawRectangleParams, NULL);
+		}
+		break;
+	case SI_UI_EVENT_TYPE_DRAW_TEXT:
+		if (gSiCallbackHub.drawTextFunction)
+		{
+			gSiCallbackHub.drawTextFunction(pEvent->drawTextParams, NULL);
+		}
+		break;
+	case SI_UI_EVENT_TYPE_DRAW_LIST:
+		if (gSiCallbackHub.drawListFunction)
+		{
+			gSiCallbackHub.drawListFunction(pEvent->drawListParams, NULL);
+		}
+		break;
+	default:
+		break;
+	};
+}
+
+/**
+ * Hand the events of a block list over to the rendering backend, in recording order. With `pRegion`, only the events
+ * of the frame whose bounds overlap it are handed over, the others can not change a pixel inside the region. With
+ * `pCulled`, the events whose flag is set are left out.
+ */
+static void dispatchDrawingEvents(SiUIEventBlock* pFirstBlock, const SiVector4* pRegion, const u8* pCulled)
+{
+	u32 primitiveIndex = 0u;
+	for (SiUIEventBlock* pBlock = pFirstBlock; pBlock != SI_NULL; pBlock = pBlock->pNext)
+	{
+		for (u32 eventIndex = 0u; eventIndex < pBlock->count; ++eventIndex, ++primitiveIndex)
+		{
+			SiUIEvent* pEvent = &pBlock->events[eventIndex];
+
+			if (pRegion != SI_NULL && !doBoundsOverlap(gpPrimitives[primitiveIndex].bounds, *pRegion))
+			{
+				continue;
+			}
+
+			if (pCulled != SI_NULL && pCulled[primitiveIndex])
+			{
+				continue;
+			}
+
+			dispatchDrawingEvent(pEvent);
+		}
+	}
+}
+
+/**
+ * Hand the events of the frame over to the rendering backend in the order computed by `reorderDrawingEvents`. With
+ * `pRegion`, only the events whose bounds overlap it are handed over.
+ */
+static void dispatchOrderedEvents(const SiUIEvent** ppEvents,
+								  const u32*		pOrder,
+								  u32				orderCount,
+								  const SiVector4*	pRegion)
+{
+	for (u32 orderIndex = 0u; orderIndex < orderCount; ++orderIndex)
+	{
+		u32 eventIndex = pOrder[orderIndex];
+		if (pRegion != SI_NULL && !doBoundsOverlap(gpPrimitives[eventIndex].bounds, *pRegion))
+		{
+			continue;
+		}
+
+		dispatchDrawingEvent(ppEvents[eventIndex]);
+	}
+}
+
+#define HASH_VALUE(hash, value) hashBytes(hash, &(value), sizeof(value))
+
+/**
+ * FNV-1a over `size` bytes, continuing from `hash`.
+ */
+static u64 hashBytes(u64 hash, const void* pData, u64 size)
+{
+	const u8* pBytes = (const u8*)pData;
+	for (u64 byteIndex = 0u; byteIndex < size; ++byteIndex)
+	{
+		hash ^= pBytes[byteIndex];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+/**
+ * Continue `hash` with the parameters of `pEvent`, including the text contents. Structures with padding are hashed
+ * field by field, so the hash only depends on their values.
+ */
+static u64 hashDrawingEvent(u64 hash, const SiUIEvent* pEvent)
+{
+	hash = HASH_VALUE(hash, pEvent->type);
+
+	switch (pEvent->type)
+	{
+	case SI_UI_EVENT_TYPE_DRAW_RECTANGLE:
+		hash = HASH_VALUE(hash, pEvent->drawRectangleParams);
+		break;
+	case SI_UI_EVENT_TYPE_DRAW_TEXT:
+		hash = HASH_VALUE(hash, pEvent->drawTextParams.x);
+		hash = HASH_VALUE(hash, pEvent->drawTextParams.y);
+		hash = HASH_VALUE(hash, pEvent->drawTextParams.color);
+		hash = HASH_VALUE(hash, pEvent->drawTextParams.pFont->id);
+		hash = HASH_VALUE(hash, pEvent->drawTextParams.pFont->sizeInPixels);
+		hash = hashBytes(hash, pEvent->drawTextParams.text, strlen(pEvent->drawTextParams.text) + 1u);
+		break;
+	case SI_UI_EVENT_TYPE_DRAW_LIST:
+		hash = HASH_VALUE(hash, pEvent->drawListParams);
+		hash = HASH_VALUE(hash, gDrawLists[pEvent->drawListParams.drawList].recordSerial);
+		break;
+	default:
+		break;
+	};
+
+	return hash;
+}
+
+/**
+ * Hash everything that decides the pixels of the frame: the window size and every drawing event.
+ */
+static u64 hashDrawingEvents(SiUIEventBlock* pFirstBlock)
+{
+	u64 hash = HASH_VALUE(FNV_OFFSET_BASIS, gSiContext.windowSize);
+
+	for (SiUIEventBlock* pBlock = pFirstBlock; pBlock != SI_NULL; pBlock = pBlock->pNext)
+	{
+		for (u32 eventIndex = 0u; eventIndex < pBlock->count; ++eventIndex)
+		{
+			hash = hashDrawingEvent(hash, &pBlock->events[eventIndex]);
+		}
+	}
+
+	return hash;
+}
+
+/**
+ * Compute the area of the screen `pEvent` may draw to.
+ */
+static SiVector4 getDrawingEventBounds(const SiUIEvent* pEvent)
+{
+	SiVector4 bounds = EMPTY_BOUNDS;
+
+	switch (pEvent->type)
+	{
+	case SI_UI_EVENT_TYPE_DRAW_RECTANGLE:
+	{
+		// Rectangles are positioned by their center.
+		const DrawRectangleParameter* pParams = &pEvent->drawRectangleParams;
+		bounds.x							  = pParams->x - pParams->width / 2.0f;
+		bounds.y							  = pParams->y - pParams->height / 2.0f;
+		bounds.z							  = pParams->x + pParams->width / 2.0f;
+		bounds.w							  = pParams->y + pParams->height / 2.0f;
+		break;
+	}
+	case SI_UI_EVENT_TYPE_DRAW_TEXT:
+		bounds = siGetTextBounds(pEvent->drawTextParams.pFont,
+								 pEvent->drawTextParams.x,
+								 pEvent->drawTextParams.y,
+								 pEvent->drawTextParams.text);
+		break;
+	case SI_UI_EVENT_TYPE_DRAW_LIST:
+		bounds = gDrawLists[pEvent->drawListParams.drawList].bounds;
+		bounds.x += pEvent->drawListParams.offsetX;
+		bounds.y += pEvent->drawListParams.offsetY;
+		bounds.z += pEvent->drawListParams.offsetX;
+		bounds.w += pEvent->drawListParams.offsetY;
+		break;
+	default:
+		break;
+	};
+
+	return bounds;
+}
+
+/**
+ * Record the hash and bounds of every drawing event of the frame, and diff them against the primitives of the last
+ * rendered frame in recording order. An event that differs dirties both the area it covered and the one it covers.
+ *
+ * @return The union of the changed areas, empty when the frame draws the same as the last rendered one.
+ */
+static SiVector4 computeDirtyRegion()
+{
+	SiPrimitive* pPrimitives   = gpPreviousPrimitives;
+	u32			 capacity	   = gPreviousPrimitiveCapacity;
+	gpPreviousPrimitives	   = gpPrimitives;
+	gPreviousPrimitiveCount	   = gPrimitiveCount;
+	gPreviousPrimitiveCapacity = gPrimitiveCapacity;
+
+	if (gDrawingEventsCount > capacity)
+	{
+		u32 newCapacity = capacity > 0u ? capacity : INITIAL_PRIMITIVE_CAPACITY;
+		while (newCapacity < gDrawingEventsCount)
+		{
+			newCapacity *= 2u;
+		}
+
+		SiPrimitive* pNewPrimitives = (SiPrimitive*)realloc(pPrimitives, sizeof(SiPrimitive) * newCapacity);
+		if (pNewPrimitives == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow the dirty region primitives to %u entries.", newCapacity);
+		}
+
+		pPrimitives = pNewPrimitives;
+		capacity	= newCapacity;
+	}
+
+	gpPrimitives	   = pPrimitives;
+	gPrimitiveCount	   = 0u;
+	gPrimitiveCapacity = capacity;
+
+	for (SiUIEventBlock* pBlock = gpFirstDrawingEventBlock; pBlock != SI_NULL; pBlock = pBlock->pNext)
+	{
+		for (u32 eventIndex = 0u; eventIndex < pBlock->count; ++eventIndex)
+		{
+			SiPrimitive* pPrimitive = &gpPrimitives[gPrimitiveCount++];
+			pPrimitive->hash		= hashDrawingEvent(FNV_OFFSET_BASIS, &pBlock->events[eventIndex]);
+			pPrimitive->bounds		= getDrawingEventBounds(&pBlock->events[eventIndex]);
+		}
+	}
+
+	SiVector4 region		 = EMPTY_BOUNDS;
+	u32		  primitiveCount = gPrimitiveCount > gPreviousPrimitiveCount ? gPrimitiveCount : gPreviousPrimitiveCount;
+	for (u32 primitiveIndex = 0u; primitiveIndex < primitiveCount; ++primitiveIndex)
+	{
+		b8 isNew = primitiveIndex < gPrimitiveCount;
+		b8 isOld = primitiveIndex < gPreviousPrimitiveCount;
+		if (isNew && isOld && gpPrimitives[primitiveIndex].hash == gpPreviousPrimitives[primitiveIndex].hash)
+		{
+			continue;
+		}
+
+		if (isNew)
+		{
+			region = unionBounds(region, gpPrimitives[primitiveIndex].bounds);
+		}
+
+		if (isOld)
+		{
+			region = unionBounds(region, gpPreviousPrimitives[primitiveIndex].bounds);
+		}
+	}
+
+	return region;
+}
+
+static b8 doesBoundsContain(SiVector4 outer, SiVector4 inner)
+{
+	return outer.x <= inner.x && outer.y <= inner.y && outer.z >= inner.z && outer.w >= inner.w;
+}
+
+/**
+ * Whether a rectangle event hides every pixel under its bounds: filled, square, untextured and fully opaque.
+ */
+static b8 isOpaqueRectangle(const SiUIEvent* pEvent)
+{
+	if (pEvent->type != SI_UI_EVENT_TYPE_DRAW_RECTANGLE)
+	{
+		return SI_FALSE;
+	}
+
+	const DrawRectangleParameter* pParams = &pEvent->drawRectangleParams;
+	return pParams->color.a == 255u && pParams->sprite.texture == SI_TEXTURE_NULL && pParams->cornerRadius == 0.0f &&
+		   pParams->borderWidth == 0.0f;
+}
+
+/**
+ * Gather the events of the frame and their bounds into arrays of the frame arena.
+ *
+ * @param pPrimitives The bounds of the events when the dirty region diff already computed them, or `SI_NULL`.
+ */
+static SiFrameEvents collectDrawingEvents(const SiPrimitive* pPrimitives)
+{
+	SiFrameEvents events = {0};
+	events.count		 = gDrawingEventsCount;
+	if (events.count == 0u)
+	{
+		return events;
+	}
+
+	SiArena* pArena = &gSiContext.frameArena;
+	events.ppEvents = (const SiUIEvent**)siArenaAllocate(
+		pArena, sizeof(const SiUIEvent*) * events.count, _Alignof(const SiUIEvent*));
+	events.pBounds	= (SiVector4*)siArenaAllocate(pArena, sizeof(SiVector4) * events.count, _Alignof(SiVector4));
+
+	u32 eventIndex = 0u;
+	for (SiUIEventBlock* pBlock = gpFirstDrawingEventBlock; pBlock != SI_NULL; pBlock = pBlock->pNext)
+	{
+		for (u32 blockEventIndex = 0u; blockEventIndex < pBlock->count; ++blockEventIndex, ++eventIndex)
+		{
+			const SiUIEvent* pEvent		= &pBlock->events[blockEventIndex];
+			events.ppEvents[eventIndex] = pEvent;
+			events.pBounds[eventIndex]	=
+				pPrimitives != SI_NULL ? pPrimitives[eventIndex].bounds : getDrawingEventBounds(pEvent);
+		}
+	}
+
+	return events;
+}
+
+/**
+ * Flag the events of the frame which can not change a pixel: the ones outside of the window and the ones whose bounds
+ * are fully covered by a single opaque rectangle drawn after them. The events are walked back to front, testing each
+ * one against the `MAX_OCCLUDERS` largest opaque rectangles seen so far. The flags live in the frame arena.
+ */
+static const u8* cullDrawingEvents(const SiFrameEvents* pEvents)
+{
+	u32 eventCount = pEvents->count;
+	if (eventCount == 0u)
+	{
+		return SI_NULL;
+	}
+
+	const SiUIEvent** ppEvents = pEvents->ppEvents;
+	const SiVector4*  pBounds  = pEvents->pBounds;
+	u8*				  pCulled  = (u8*)siArenaAllocate(&gSiContext.frameArena, sizeof(u8) * eventCount, _Alignof(u8));
+
+	// Drawing coordinates span twice the framebuffer size (see the default renderer's vertex shaders).
+	SiVector4 viewport = {0.0f, 0.0f, gSiContext.windowSize.x * 2.0f, gSiContext.windowSize.y * 2.0f};
+
+	SiVector4 occluders[MAX_OCCLUDERS];
+	f32		  occluderAreas[MAX_OCCLUDERS];
+	u32		  occluderCount = 0u;
+
+	for (u32 index = eventCount; index-- > 0u;)
+	{
+		SiVector4 bounds = pBounds[index];
+		pCulled[index]	 = SI_FALSE;
+
+		if (!doBoundsOverlap(bounds, viewport))
+		{
+			pCulled[index] = SI_TRUE;
+			gFrameStats.culledOffscreenCount++;
+			continue;
+		}
+
+		for (u32 occluderIndex = 0u; occluderIndex < occluderCount; ++occluderIndex)
+		{
+			if (doesBoundsContain(occluders[occluderIndex], bounds))
+			{
+				pCulled[index] = SI_TRUE;
+				break;
+			}
+		}
+
+		if (pCulled[index])
+		{
+			gFrameStats.culledOccludedCount++;
+			continue;
+		}
+
+		if (!isOpaqueRectangle(ppEvents[index]))
+		{
+			continue;
+		}
+
+		// A full set keeps the largest rectangles, they are the likeliest to cover something.
+		f32 area		  = (bounds.z - bounds.x) * (bounds.w - bounds.y);
+		u32 occluderIndex = occluderCount;
+		if (occluderCount < MAX_OCCLUDERS)
+		{
+			occluderCount++;
+		}
+		else
+		{
+			occluderIndex = 0u;
+			for (u32 candidateIndex = 1u; candidateIndex < MAX_OCCLUDERS; ++candidateIndex)
+			{
+				if (occluderAreas[candidateIndex] < occluderAreas[occluderIndex])
+				{
+					occluderIndex = candidateIndex;
+				}
+			}
+
+			if (occluderAreas[occluderIndex] >= area)
+			{
+				continue;
+			}
+		}
+
+		occluders[occluderIndex]	 = bounds;
+		occluderAreas[occluderIndex] = area;
+	}
+
+	return pCulled;
+}
+
+/**
+ * The material an event is batched with by the backend: the shader and texture of a rectangle, the glyph atlas and
+ * the rasterization of a text, since bitmap and distance field glyphs are drawn by different shaders. Draw lists are
+ * replayed on their own and never share a material.
+ */
+static u64 getMaterialKey(const SiUIEvent* pEvent)
+{
+	switch (pEvent->type)
+	{
+	case SI_UI_EVENT_TYPE_DRAW_RECTANGLE:
+		return ((u64)SI_UI_EVENT_TYPE_DRAW_RECTANGLE << 32u) | pEvent->drawRectangleParams.sprite.texture;
+	case SI_UI_EVENT_TYPE_DRAW_TEXT:
+		return ((u64)SI_UI_EVENT_TYPE_DRAW_TEXT << 32u) | (u32)pEvent->drawTextParams.pFont->rasterization;
+	default:
+		return MATERIAL_KEY_NONE;
+	}
+}
+
+/**
+ * Compute a dispatch order grouping the events which share a material, with the same image as the recording order.
+ * An event joins the latest group of its material only when no group recorded after that one overlaps its bounds, so
+ * it is never moved across anything it overlaps. Only the `MAX_REORDER_LOOKBACK` latest groups are searched. The
+ * order lives in the frame arena, culled events are left out of it.
+ *
+ * @return The indices of the events to dispatch in dispatch order, `*pOrderCount` of them.
+ */
+static const u32* reorderDrawingEvents(const SiFrameEvents* pEvents, const u8* pCulled, u32* pOrderCount)
+{
+	*pOrderCount = 0u;
+
+	u32 eventCount = pEvents->count;
+	if (eventCount == 0u)
+	{
+		return SI_NULL;
+	}
+
+	SiArena*	  pArena	 = &gSiContext.frameArena;
+	SiEventGroup* pGroups	 = (SiEventGroup*)siArenaAllocate(
+		pArena, sizeof(SiEventGroup) * eventCount, _Alignof(SiEventGroup));
+	u32*		  pNextEvent = (u32*)siArenaAllocate(pArena, sizeof(u32) * eventCount, _Alignof(u32));
+	u32*		  pOrder	 = (u32*)siArenaAllocate(pArena, sizeof(u32) * eventCount, _Alignof(u32));
+	u32			  groupCount = 0u;
+
+	for (u32 eventIndex = 0u; eventIndex < eventCount; ++eventIndex)
+	{
+		if (pCulled != SI_NULL && pCulled[eventIndex])
+		{
+			continue;
+		}
+
+		u64		  materialKey = getMaterialKey(pEvents->ppEvents[eventIndex]);
+		SiVector4 bounds	  = pEvents->pBounds[eventIndex];
+		pNextEvent[eventIndex] = EVENT_INDEX_NONE;
+
+		u32 groupIndex	  = groupCount;
+		u32 lookbackCount = groupCount < MAX_REORDER_LOOKBACK ? groupCount : MAX_REORDER_LOOKBACK;
+		for (u32 candidateIndex = groupCount; candidateIndex-- > groupCount - lookbackCount;)
+		{
+			if (materialKey != MATERIAL_KEY_NONE && pGroups[candidateIndex].materialKey == materialKey)
+			{
+				groupIndex = candidateIndex;
+				break;
+			}
+
+			if (doBoundsOverlap(pGroups[candidateIndex].bounds, bounds))
+			{
+				break;
+			}
+		}
+
+		if (groupIndex == groupCount)
+		{
+			SiEventGroup* pGroup = &pGroups[groupCount++];
+			pGroup->materialKey	 = materialKey;
+			pGroup->bounds		 = bounds;
+			pGroup->firstEvent	 = eventIndex;
+			pGroup->lastEvent	 = eventIndex;
+			continue;
+		}
+
+		SiEventGroup* pGroup		  = &pGroups[groupIndex];
+		pNextEvent[pGroup->lastEvent] = eventIndex;
+		pGroup->lastEvent			  = eventIndex;
+		pGroup->bounds				  = unionBounds(pGroup->bounds, bounds);
+	}
+
+	for (u32 groupIndex = 0u; groupIndex < groupCount; ++groupIndex)
+	{
+		u32 eventIndex = pGroups[groupIndex].firstEvent;
+		while (eventIndex != EVENT_INDEX_NONE)
+		{
+			pOrder[(*pOrderCount)++] = eventIndex;
+			eventIndex				 = pNextEvent[eventIndex];
+		}
+	}
+
+	gFrameStats.materialGroupCount = groupCount;
+	return pOrder;
+}
+
+/**
+ * Release the memory of a rendered frame: its frame arena and the thread recordings merged into it.
+ */
+static void releaseFrameMemory(SiArena* pArena)
+{
+	siArenaReset(pArena);
+	if (pArena->highWaterBytes > gFrameStats.arenaHighWaterBytes)
+	{
+		gFrameStats.arenaHighWaterBytes = pArena->highWaterBytes;
+	}
+	gFrameStats.arenaReservedBytes = gSiContext.frameArena.reservedBytes + gRenderFrameArena.reservedBytes;
+
+	// Recordings submitted after the merge are kept for the next frame.
+	siLockMutex(gpThreadRecordingMutex);
+	for (u32 recordingIndex = 0u; recordingIndex < SI_MAX_THREAD_RECORDINGS; ++recordingIndex)
+	{
+		SiThreadRecording* pRecording = &gThreadRecordings[recordingIndex];
+		if (pRecording->isMerged)
+		{
+			siArenaReset(&pRecording->arena);
+			pRecording->pFirstBlock = SI_NULL;
+			pRecording->pLastBlock	= SI_NULL;
+			pRecording->eventCount	= 0u;
+			pRecording->isUsed		= SI_FALSE;
+			pRecording->isSubmitted = SI_FALSE;
+			pRecording->isMerged	= SI_FALSE;
+		}
+	}
+	siUnlockMutex(gpThreadRecordingMutex);
+}
+
+/**
+ * Keep the glyphs of the draw lists replayed by a frame in the glyph atlas. Their shelves are touched before anything
+ * is dispatched, so text drawn earlier in the frame can not evict them, culled or clipped replays included.
+ */
+static void touchReplayedGlyphs(SiUIEventBlock* pFirstBlock)
+{
+	for (SiUIEventBlock* pBlock = pFirstBlock; pBlock != SI_NULL; pBlock = pBlock->pNext)
+	{
+		for (u32 eventIndex = 0u; eventIndex < pBlock->count; ++eventIndex)
+		{
+			const SiUIEvent* pEvent = &pBlock->events[eventIndex];
+			if (pEvent->type == SI_UI_EVENT_TYPE_DRAW_LIST)
+			{
+				siTouchGlyphShelves(&gDrawLists[pEvent->drawListParams.drawList].glyphShelves);
+			}
+		}
+	}
+}
+
+/**
+ * Flag the draw lists whose glyphs were evicted from the glyph atlas. Called by the thread owning the context after
+ * glyphs were looked up, other threads only read the flags, under the render mutex.
+ */
+static void updateDrawListGlyphs()
+{
+	if (gpRenderMutex != SI_NULL)
+	{
+		siLockMutex(gpRenderMutex);
+	}
+
+	for (SiDrawList drawList = 0u; drawList < SI_MAX_DRAW_LISTS; ++drawList)
+	{
+		gDrawLists[drawList].hasEvictedGlyphs = !siAreGlyphShelvesValid(&gDrawLists[drawList].glyphShelves);
+	}
+
+	if (gpRenderMutex != SI_NULL)
+	{
+		siUnlockMutex(gpRenderMutex);
+	}
+}
+
+/**
+ * Render a frame with the backend, on the calling thread or on the render thread.
+ */
+static void renderFrame(const SiRenderFrame* pFrame)
+{
+	gSiContext.renderWindowSize = pFrame->windowSize;
+
+	if (pFrame->isUnchanged)
+	{
+		// Glyphs staged while recording a draw list are uploaded anyway, so the staging memory does not pile up.
+		siFlushFontAtlas();
+
+		if (gSiCallbackHub.skipFrameFunction)
+		{
+			gSiCallbackHub.skipFrameFunction();
+		}
+		return;
+	}
+
+	if (pFrame->hasDirtyRegion)
+	{
+		gSiCallbackHub.setDirtyRegionFunction(pFrame->dirtyRegion);
+	}
+
+	if (gSiCallbackHub.beginFrameFunction)
+	{
+		gSiCallbackHub.beginFrameFunction();
+	}
+
+	touchReplayedGlyphs(pFrame->pFirstBlock);
+
+	const SiVector4* pRegion = pFrame->isPartial ? &pFrame->dirtyRegion : SI_NULL;
+	if (pFrame->pOrder != SI_NULL)
+	{
+		dispatchOrderedEvents(pFrame->ppEvents, pFrame->pOrder, pFrame->orderCount, pRegion);
+	}
+	else
+	{
+		dispatchDrawingEvents(pFrame->pFirstBlock, pRegion, pFrame->pCulled);
 	}
 
-SiCallbackHub gSiCallbackHub = {0};
-SiContext	  gSiContext	 = {0};
+	updateDrawListGlyphs();
+	siFlushFontAtlas();
+
+	if (gSiCallbackHub.endFrameFunction)
+	{
+		gSiCallbackHub.endFrameFunction();
+	}
+}
+
+/**
+ * Body of the render thread. The thread owns the graphics context, except while the application thread holds it
+ * through `siAcquireRenderContext`. A pending frame is always rendered before the context is handed over.
+ */
+static void runRenderThread(void* pArgument)
+{
+	(void)pArgument;
+
+	gIsRenderThread = SI_TRUE;
+	gSiCallbackHub.makeContextCurrentFunction(SI_TRUE);
+
+	siLockMutex(gpRenderMutex);
+	while (SI_TRUE)
+	{
+		while (!gIsFramePending && !gIsContextRequested && !gShouldStopRenderThread)
+		{
+			siWaitCondition(gpRenderCondition, gpRenderMutex);
+		}
+
+		if (gIsFramePending)
+		{
+			SiRenderFrame frame = gRenderFrame;
+			siUnlockMutex(gpRenderMutex);
+			renderFrame(&frame);
+			siLockMutex(gpRenderMutex);
+
+			gIsFramePending = SI_FALSE;
+			siBroadcastCondition(gpRenderCondition);
+			continue;
+		}
+
+		if (gShouldStopRenderThread)
+		{
+			break;
+		}
+
+		gSiCallbackHub.makeContextCurrentFunction(SI_FALSE);
+		gIsContextReleased = SI_TRUE;
+		siBroadcastCondition(gpRenderCondition);
+
+		// Waiting on the request would miss a release directly followed by the next acquire, which sets it again.
+		while (gIsContextReleased)
+		{
+			siWaitCondition(gpRenderCondition, gpRenderMutex);
+		}
+		gSiCallbackHub.makeContextCurrentFunction(SI_TRUE);
+	}
+	siUnlockMutex(gpRenderMutex);
+
+	gSiCallbackHub.makeContextCurrentFunction(SI_FALSE);
+}
+
+/**
+ * Block until the render thread finished the frame handed over by the last `siRender`.
+ */
+static void waitForRenderThread()
+{
+	siLockMutex(gpRenderMutex);
+	while (gIsFramePending)
+	{
+		siWaitCondition(gpRenderCondition, gpRenderMutex);
+	}
+	siUnlockMutex(gpRenderMutex);
+}
+
+/**
+ * Start the render thread and hand the graphics context over to it.
+ */
+static void startRenderThread(u64 frameArenaSize)
+{
+	if (gSiCallbackHub.makeContextCurrentFunction == SI_NULL)
+	{
+		SI_ERROR_EXIT("The render thread needs a make context current function.");
+	}
+
+	siArenaInitialize(&gRenderFrameArena, frameArenaSize);
+	gpRenderMutex			= siCreateMutex();
+	gpRenderCondition		= siCreateCondition();
+	gIsFramePending			= SI_FALSE;
+	gIsContextRequested		= SI_FALSE;
+	gIsContextReleased		= SI_FALSE;
+	gShouldStopRenderThread = SI_FALSE;
+	gRenderContextDepth		= 0u;
+
+	// A context can only be current on one thread at a time.
+	gSiCallbackHub.makeContextCurrentFunction(SI_FALSE);
+	gpRenderThread = siCreateThread(runRenderThread, SI_NULL);
+}
+
+/**
+ * Let the render thread finish its frame, stop it and take the graphics context back.
+ */
+static void stopRenderThread()
+{
+	waitForRenderThread();
+
+	siLockMutex(gpRenderMutex);
+	gShouldStopRenderThread = SI_TRUE;
+	siBroadcastCondition(gpRenderCondition);
+	siUnlockMutex(gpRenderMutex);
+
+	siJoinThread(gpRenderThread);
+	gpRenderThread = SI_NULL;
+	gSiCallbackHub.makeContextCurrentFunction(SI_TRUE);
+
+	siDestroyCondition(gpRenderCondition);
+	siDestroyMutex(gpRenderMutex);
+	gpRenderCondition = SI_NULL;
+	gpRenderMutex	  = SI_NULL;
 
-static SiUIEvent gDrawingEvents[DRAWING_EVENT_BUFFER_SIZE];
-static u32		 gDrawingEventsCount	   = 0u;
-static u32		 gCurrentDrawingEventIndex = 0u;
+	releaseFrameMemory(&gRenderFrameArena);
+	siArenaShutdown(&gRenderFrameArena);
+	memset(&gRenderFrameArena, 0, sizeof(SiArena));
+}
 
 void siInitialize(SiConfig config)
 {
 	gSiContext.isRunning   = SI_TRUE;
 	gSiContext.isBigEndian = isBigEndian();
 
+	memset(&gFrameStats, 0, sizeof(SiFrameStats));
+	siArenaInitialize(&gSiContext.frameArena,
+					  config.frameArenaSize != 0u ? config.frameArenaSize : SI_DEFAULT_FRAME_ARENA_SIZE);
+	gpFirstDrawingEventBlock = SI_NULL;
+	gpLastDrawingEventBlock	 = SI_NULL;
+	gDrawingEventsCount		 = 0u;
+
+	memset(gDrawLists, 0, sizeof(gDrawLists));
+	gRecordingDrawList = SI_DRAW_LIST_NULL;
+
+	gSkipUnchangedFrames = config.skipUnchangedFrames;
+	gIsFrameDirty		 = SI_TRUE;
+	gLastFrameHash		 = 0u;
+
+	memset(gThreadRecordings, 0, sizeof(gThreadRecordings));
+	gpThreadRecordingMutex	  = siCreateMutex();
+	gThreadSubmissionCount	  = 0u;
+	gThreadRecordingArenaSize = config.frameArenaSize != 0u ? config.frameArenaSize : SI_DEFAULT_FRAME_ARENA_SIZE;
+
+	gRedrawDirtyRegions		= config.redrawDirtyRegions;
+	gCullHiddenPrimitives	= config.cullHiddenPrimitives;
+	gReorderForBatching		= config.reorderForBatching;
+	gImageUploadBudget		= config.imageUploadBudgetSeconds > 0.0 ? config.imageUploadBudgetSeconds
+																	: SI_DEFAULT_IMAGE_UPLOAD_BUDGET;
+	gPreviousWindowSize		= (SiVector2){0.0f, 0.0f};
+	gPrimitiveCount			= 0u;
+	gPreviousPrimitiveCount = 0u;
+
+	siSetTextureCacheDirectory(config.textureCacheDirectory);
+	siSetFontCacheDirectory(config.fontCacheDirectory);
+	gSiContext.shaderCacheDirectory = config.shaderCacheDirectory;
+
 	if (gSiCallbackHub.initializeFunction)
 	{
 		gSiCallbackHub.initializeFunction();
@@ -34,7 +1099,13 @@ void siInitialize(SiConfig config)
 		SI_ERROR_EXIT("Window size function is not set.");
 	}
 
-	siFontLoad(config.fontFile, &gSiContext.defaultFont, config.fontSizeInPixels);
+	siFontLoad(config.fontFile, &gSiContext.defaultFont, config.fontSizeInPixels, config.fontRasterization);
+
+	gSiContext.useRenderThread = config.useRenderThread;
+	if (config.useRenderThread)
+	{
+		startRenderThread(config.frameArenaSize != 0u ? config.frameArenaSize : SI_DEFAULT_FRAME_ARENA_SIZE);
+	}
 }
 
 void siPollEvents()
@@ -52,52 +1123,229 @@ b8 siRunning()
 
 void siRender()
 {
-	if (gSiCallbackHub.beginFrameFunction)
+	if (gRecordingDrawList != SI_DRAW_LIST_NULL)
 	{
-		gSiCallbackHub.beginFrameFunction();
+		SI_ERROR_EXIT("siRender called while recording a draw list, siEndDrawList is missing.");
 	}
 
+	// The events of the previous frame are only released once the render thread is done with them.
+	if (gpRenderThread != SI_NULL)
+	{
+		waitForRenderThread();
+		releaseFrameMemory(&gRenderFrameArena);
+	}
+
+#ifdef SIMUI_USE_STB
+	// Images finished now are drawn from the next recorded frame on, this one still references their placeholders.
+	siUploadLoadedImages(gImageUploadBudget);
+#endif // SIMUI_USE_STB
+
+	mergeThreadRecordings();
+
 	gSiContext.windowSize = gSiCallbackHub.getWindowSizeFunction(gSiContext.pRenderingData);
 
-	for (u32 eventIndex = 0u; eventIndex < gDrawingEventsCount; ++eventIndex)
+	// Nothing can be kept from the last frame after a resize or an explicit request.
+	b8 isFrameDirty = gIsFrameDirty || gSiContext.windowSize.x != gPreviousWindowSize.x ||
+					  gSiContext.windowSize.y != gPreviousWindowSize.y;
+
+	gIsFrameDirty		= SI_FALSE;
+	gPreviousWindowSize = gSiContext.windowSize;
+
+	b8 isUnchanged = SI_FALSE;
+	if (gSkipUnchangedFrames)
 	{
-		SiUIEvent* pEvent = &gDrawingEvents[eventIndex];
+		u64 frameHash  = hashDrawingEvents(gpFirstDrawingEventBlock);
+		isUnchanged	   = !isFrameDirty && frameHash == gLastFrameHash;
+		gLastFrameHash = frameHash;
+	}
 
-		switch (pEvent->type)
+	// A frame skipped by its hash has the same primitives as the last rendered one, so the diff can be left out.
+	SiVector4		   dirtyRegion	  = FULL_REGION;
+	b8				   isPartialFrame = SI_FALSE;
+	const SiPrimitive* pPrimitives	  = SI_NULL;
+	if (!isUnchanged && gRedrawDirtyRegions && gSiCallbackHub.setDirtyRegionFunction)
+	{
+		SiVector4 changedRegion = computeDirtyRegion();
+		pPrimitives				= gpPrimitives;
+		if (!isFrameDirty)
 		{
-		case SI_UI_EVENT_TYPE_DRAW_RECTANGLE:
-			if (gSiCallbackHub.drawRectangleFunction)
-			{
-				gSiCallbackHub.drawRectangleFunction(pEvent->drawRectangleParams, NULL);
-			}
-			break;
-		case SI_UI_EVENT_TYPE_DRAW_TEXT:
-			if (gSiCallbackHub.drawTextFunction)
-			{
-				gSiCallbackHub.drawTextFunction(pEvent->drawTextParams, NULL);
-			}
-		default:
-			break;
-		};
+			dirtyRegion	   = changedRegion;
+			isPartialFrame = SI_TRUE;
+			isUnchanged	   = changedRegion.x > changedRegion.z;
+		}
 	}
 
-	if (gSiCallbackHub.endFrameFunction)
+	SiRenderFrame frame	 = {0};
+	frame.pFirstBlock	 = gpFirstDrawingEventBlock;
+	frame.windowSize	 = gSiContext.windowSize;
+	frame.dirtyRegion	 = dirtyRegion;
+	frame.isUnchanged	 = isUnchanged;
+	frame.isPartial		 = isPartialFrame;
+	frame.hasDirtyRegion = gRedrawDirtyRegions && gSiCallbackHub.setDirtyRegionFunction != SI_NULL;
+
+	gFrameStats.culledOffscreenCount = 0u;
+	gFrameStats.culledOccludedCount	 = 0u;
+	gFrameStats.materialGroupCount	 = 0u;
+	if (!isUnchanged && (gCullHiddenPrimitives || gReorderForBatching))
 	{
-		gSiCallbackHub.endFrameFunction();
+		SiFrameEvents events = collectDrawingEvents(pPrimitives);
+
+		if (gCullHiddenPrimitives)
+		{
+			frame.pCulled = cullDrawingEvents(&events);
+		}
+
+		if (gReorderForBatching)
+		{
+			frame.ppEvents = events.ppEvents;
+			frame.pOrder   = reorderDrawingEvents(&events, frame.pCulled, &frame.orderCount);
+		}
+	}
+
+	gFrameStats.eventCount	   = gDrawingEventsCount;
+	gFrameStats.arenaUsedBytes = gSiContext.frameArena.usedBytes;
+	if (gDrawingEventsCount > gFrameStats.eventHighWaterMark)
+	{
+		gFrameStats.eventHighWaterMark = gDrawingEventsCount;
+	}
+	if (isUnchanged)
+	{
+		gFrameStats.skippedFrameCount++;
+	}
+
+	gpFirstDrawingEventBlock = SI_NULL;
+	gpLastDrawingEventBlock	 = SI_NULL;
+	gDrawingEventsCount		 = 0u;
+
+	if (gpRenderThread == SI_NULL)
+	{
+		renderFrame(&frame);
+		releaseFrameMemory(&gSiContext.frameArena);
+		return;
 	}
 
-	gDrawingEventsCount		  = 0u;
-	gCurrentDrawingEventIndex = 0u;
+	// The frame keeps its arena on the render thread, the next frame is recorded into the other one.
+	SiArena renderArena	  = gSiContext.frameArena;
+	gSiContext.frameArena = gRenderFrameArena;
+	gRenderFrameArena	  = renderArena;
+
+	siLockMutex(gpRenderMutex);
+	gRenderFrame	= frame;
+	gIsFramePending = SI_TRUE;
+	siBroadcastCondition(gpRenderCondition);
+	siUnlockMutex(gpRenderMutex);
 }
 
 void siShutdown()
 {
+	if (gpRenderThread != SI_NULL)
+	{
+		stopRenderThread();
+	}
+
+	for (SiDrawList drawList = 0u; drawList < SI_MAX_DRAW_LISTS; ++drawList)
+	{
+		if (gDrawLists[drawList].isUsed)
+		{
+			siDestroyDrawList(drawList);
+		}
+	}
+
 	siFontUnload(&gSiContext.defaultFont);
+	siAtlasClear();
+#ifdef SIMUI_USE_STB
+	siShutdownImageLoader();
+#endif // SIMUI_USE_STB
 
 	if (gSiCallbackHub.shutdownFunction)
 	{
 		gSiCallbackHub.shutdownFunction();
 	}
+
+	siArenaShutdown(&gSiContext.frameArena);
+
+	for (u32 recordingIndex = 0u; recordingIndex < SI_MAX_THREAD_RECORDINGS; ++recordingIndex)
+	{
+		if (gThreadRecordings[recordingIndex].arena.pFirstChunk != SI_NULL)
+		{
+			siArenaShutdown(&gThreadRecordings[recordingIndex].arena);
+		}
+	}
+
+	siDestroyMutex(gpThreadRecordingMutex);
+	gpThreadRecordingMutex = SI_NULL;
+
+	free(gpPrimitives);
+	free(gpPreviousPrimitives);
+	gpPrimitives			   = SI_NULL;
+	gpPreviousPrimitives	   = SI_NULL;
+	gPrimitiveCapacity		   = 0u;
+	gPreviousPrimitiveCapacity = 0u;
+}
+
+void siAcquireRenderContext()
+{
+	if (gpRenderThread == SI_NULL || gIsRenderThread)
+	{
+		return;
+	}
+
+	if (gRenderContextDepth++ > 0u)
+	{
+		return;
+	}
+
+	// The request stays set while an application thread holds the context, other threads wait for it to be released.
+	siLockMutex(gpRenderMutex);
+	while (gIsContextRequested)
+	{
+		siWaitCondition(gpRenderCondition, gpRenderMutex);
+	}
+	gIsContextRequested = SI_TRUE;
+	siBroadcastCondition(gpRenderCondition);
+	while (!gIsContextReleased)
+	{
+		siWaitCondition(gpRenderCondition, gpRenderMutex);
+	}
+	siUnlockMutex(gpRenderMutex);
+
+	gSiCallbackHub.makeContextCurrentFunction(SI_TRUE);
+}
+
+void siReleaseRenderContext()
+{
+	if (gpRenderThread == SI_NULL || gIsRenderThread)
+	{
+		return;
+	}
+
+	if (gRenderContextDepth == 0u)
+	{
+		SI_ERROR_EXIT("siReleaseRenderContext called without siAcquireRenderContext.");
+	}
+
+	if (--gRenderContextDepth > 0u)
+	{
+		return;
+	}
+
+	gSiCallbackHub.makeContextCurrentFunction(SI_FALSE);
+
+	siLockMutex(gpRenderMutex);
+	gIsContextRequested = SI_FALSE;
+	gIsContextReleased	= SI_FALSE;
+	siBroadcastCondition(gpRenderCondition);
+	siUnlockMutex(gpRenderMutex);
+}
+
+SiFrameStats siGetFrameStats()
+{
+	return gFrameStats;
+}
+
+void siMarkFrameDirty()
+{
+	gIsFrameDirty = SI_TRUE;
 }
 
 void siDrawRectangle(f32 x, f32 y, f32 width, f32 height, SiColor color, SiTexture texture)
@@ -113,9 +1361,7 @@ void siDrawRectangle(f32 x, f32 y, f32 width, f32 height, SiColor color, SiTextu
 
 void siDrawRectangleSprite(f32 x, f32 y, f32 width, f32 height, SiColor color, SiSprite sprite)
 {
-	CHECK_DRAWING_EVENT_BUFFER_CAPACITY();
-
-	SiUIEvent* pEvent					= &gDrawingEvents[gDrawingEventsCount++];
+	SiUIEvent* pEvent					= pushDrawingEvent();
 	pEvent->type						= SI_UI_EVENT_TYPE_DRAW_RECTANGLE;
 	pEvent->drawRectangleParams.x		= x;
 	pEvent->drawRectangleParams.y		= y;
@@ -126,16 +1372,33 @@ void siDrawRectangleSprite(f32 x, f32 y, f32 width, f32 height, SiColor color, S
 	pEvent->drawRectangleParams.color.b = color.b;
 	pEvent->drawRectangleParams.color.a = color.a;
 	pEvent->drawRectangleParams.sprite	= sprite;
+
+	pEvent->drawRectangleParams.cornerRadius = 0.0f;
+	pEvent->drawRectangleParams.borderWidth	 = 0.0f;
+}
+
+void siDrawRoundedRectangle(f32 x, f32 y, f32 width, f32 height, SiColor color, f32 cornerRadius, f32 borderWidth)
+{
+	SiUIEvent* pEvent						 = pushDrawingEvent();
+	pEvent->type							 = SI_UI_EVENT_TYPE_DRAW_RECTANGLE;
+	pEvent->drawRectangleParams.x			 = x;
+	pEvent->drawRectangleParams.y			 = y;
+	pEvent->drawRectangleParams.width		 = width;
+	pEvent->drawRectangleParams.height		 = height;
+	pEvent->drawRectangleParams.color		 = color;
+	pEvent->drawRectangleParams.sprite		 = (SiSprite){SI_TEXTURE_NULL, {0.0f, 0.0f}, {1.0f, 1.0f}};
+	pEvent->drawRectangleParams.cornerRadius = cornerRadius;
+	pEvent->drawRectangleParams.borderWidth	 = borderWidth;
 }
 
 void siDrawText(f32 x, f32 y, const char* text, SiColor color, SiFont* pFont)
 {
-	CHECK_DRAWING_EVENT_BUFFER_CAPACITY();
-	SiUIEvent* pEvent			   = &gDrawingEvents[gDrawingEventsCount++];
+	// The text is copied into the recording arena, so the caller's buffer may be reused right after this call.
+	SiUIEvent* pEvent			   = pushDrawingEvent();
 	pEvent->type				   = SI_UI_EVENT_TYPE_DRAW_TEXT;
 	pEvent->drawTextParams.x	   = x;
 	pEvent->drawTextParams.y	   = y;
-	pEvent->drawTextParams.text	   = text;
+	pEvent->drawTextParams.text	   = siArenaCopyString(getRecordingArena(), text);
 	pEvent->drawTextParams.color.r = color.r;
 	pEvent->drawTextParams.color.g = color.g;
 	pEvent->drawTextParams.color.b = color.b;
@@ -143,10 +1406,234 @@ void siDrawText(f32 x, f32 y, const char* text, SiColor color, SiFont* pFont)
 	pEvent->drawTextParams.pFont   = pFont;
 }
 
+// =========================== Thread Recording ===========================
+void siBeginThreadRecording(u32 sortKey)
+{
+	if (gpThreadRecording != SI_NULL)
+	{
+		SI_ERROR_EXIT("The calling thread is already recording, siEndThreadRecording is missing.");
+	}
+
+	SiThreadRecording* pRecording = SI_NULL;
+
+	siLockMutex(gpThreadRecordingMutex);
+	for (u32 recordingIndex = 0u; recordingIndex < SI_MAX_THREAD_RECORDINGS; ++recordingIndex)
+	{
+		if (!gThreadRecordings[recordingIndex].isUsed)
+		{
+			pRecording		   = &gThreadRecordings[recordingIndex];
+			pRecording->isUsed = SI_TRUE;
+			break;
+		}
+	}
+	siUnlockMutex(gpThreadRecordingMutex);
+
+	if (pRecording == SI_NULL)
+	{
+		SI_ERROR_EXIT("Too many thread recordings, at most %u can wait for siRender.", SI_MAX_THREAD_RECORDINGS);
+	}
+
+	// The slot is owned by the calling thread from here on, its arena is reused across frames.
+	if (pRecording->arena.pFirstChunk == SI_NULL)
+	{
+		siArenaInitialize(&pRecording->arena, gThreadRecordingArenaSize);
+	}
+
+	pRecording->sortKey = sortKey;
+	gpThreadRecording	= pRecording;
+}
+
+void siEndThreadRecording()
+{
+	if (gpThreadRecording == SI_NULL)
+	{
+		SI_ERROR_EXIT("siEndThreadRecording called without siBeginThreadRecording.");
+	}
+
+	siLockMutex(gpThreadRecordingMutex);
+	gpThreadRecording->submissionIndex = gThreadSubmissionCount++;
+	gpThreadRecording->isSubmitted	   = SI_TRUE;
+	siUnlockMutex(gpThreadRecordingMutex);
+
+	gpThreadRecording = SI_NULL;
+}
+
+// =========================== Draw Lists ===========================
+SiDrawList siCreateDrawList()
+{
+	SiDrawList drawList = 0u;
+	for (drawList = 0u; drawList < SI_MAX_DRAW_LISTS; ++drawList)
+	{
+		if (!gDrawLists[drawList].isUsed)
+		{
+			break;
+		}
+	}
+
+	if (drawList == SI_MAX_DRAW_LISTS)
+	{
+		SI_ERROR_EXIT("Too many draw lists, at most %u can exist at once.", SI_MAX_DRAW_LISTS);
+	}
+
+	memset(&gDrawLists[drawList], 0, sizeof(SiDrawListData));
+	gDrawLists[drawList].isUsed = SI_TRUE;
+
+	return drawList;
+}
+
+void siBeginDrawList(SiDrawList drawList)
+{
+	DRAW_LIST_VALIDATE(drawList);
+
+	if (gRecordingDrawList != SI_DRAW_LIST_NULL)
+	{
+		SI_ERROR_EXIT("Draw list %u is already being recorded.", gRecordingDrawList);
+	}
+
+	if (gpThreadRecording != SI_NULL)
+	{
+		SI_ERROR_EXIT("Draw lists can not be recorded inside a thread recording.");
+	}
+
+	gRecordingDrawList				= drawList;
+	gpFirstRecordedEventBlock		= SI_NULL;
+	gpLastRecordedEventBlock		= SI_NULL;
+	gDrawLists[drawList].isRecorded	= SI_FALSE;
+}
+
+void siEndDrawList()
+{
+	if (gRecordingDrawList == SI_DRAW_LIST_NULL)
+	{
+		SI_ERROR_EXIT("siEndDrawList called without siBeginDrawList.");
+	}
+
+	// The recording flag is cleared first so nothing the backend triggers can land in the recorded events.
+	SiDrawList drawList = gRecordingDrawList;
+	gRecordingDrawList	= SI_DRAW_LIST_NULL;
+
+	siAcquireRenderContext();
+
+	if (gSiCallbackHub.beginDrawListFunction)
+	{
+		gSiCallbackHub.beginDrawListFunction(drawList);
+	}
+
+	// The glyphs are looked up while the backend builds the geometry, their shelves are what the list depends on.
+	siCaptureGlyphShelves(&gDrawLists[drawList].glyphShelves);
+	dispatchDrawingEvents(gpFirstRecordedEventBlock, SI_NULL, SI_NULL);
+	siCaptureGlyphShelves(SI_NULL);
+
+	// Recording may have evicted glyphs of other lists.
+	updateDrawListGlyphs();
+
+	if (gSiCallbackHub.endDrawListFunction)
+	{
+		gSiCallbackHub.endDrawListFunction(drawList);
+	}
+
+	siReleaseRenderContext();
+
+	gDrawLists[drawList].isRecorded	  = SI_TRUE;
+	gDrawLists[drawList].recordSerial = ++gDrawListRecordSerial;
+	gDrawLists[drawList].bounds		  = EMPTY_BOUNDS;
+
+	// The passes working on bounds treat a replay as a single primitive covering everything the list draws.
+	if (gRedrawDirtyRegions || gCullHiddenPrimitives || gReorderForBatching)
+	{
+		for (SiUIEventBlock* pBlock = gpFirstRecordedEventBlock; pBlock != SI_NULL; pBlock = pBlock->pNext)
+		{
+			for (u32 eventIndex = 0u; eventIndex < pBlock->count; ++eventIndex)
+			{
+				gDrawLists[drawList].bounds =
+					unionBounds(gDrawLists[drawList].bounds, getDrawingEventBounds(&pBlock->events[eventIndex]));
+			}
+		}
+	}
+
+	gpFirstRecordedEventBlock = SI_NULL;
+	gpLastRecordedEventBlock  = SI_NULL;
+}
+
+void siDrawList(SiDrawList drawList, f32 offsetX, f32 offsetY)
+{
+	DRAW_LIST_VALIDATE(drawList);
+
+	if (gpThreadRecording == SI_NULL && gRecordingDrawList != SI_DRAW_LIST_NULL)
+	{
+		SI_ERROR_EXIT("Draw lists can not be replayed while recording another draw list.");
+	}
+
+	SiUIEvent* pEvent				= pushDrawingEvent();
+	pEvent->type					= SI_UI_EVENT_TYPE_DRAW_LIST;
+	pEvent->drawListParams.drawList = drawList;
+	pEvent->drawListParams.offsetX	= offsetX;
+	pEvent->drawListParams.offsetY	= offsetY;
+}
+
+void siInvalidateDrawList(SiDrawList drawList)
+{
+	DRAW_LIST_VALIDATE(drawList);
+	gDrawLists[drawList].isRecorded = SI_FALSE;
+}
+
+b8 siIsDrawListValid(SiDrawList drawList)
+{
+	DRAW_LIST_VALIDATE(drawList);
+
+	SiDrawListData* pDrawList = &gDrawLists[drawList];
+	if (!pDrawList->isRecorded)
+	{
+		return SI_FALSE;
+	}
+
+	// Glyphs are looked up when the list is recorded, so evicting any of them leaves stale texture coordinates behind.
+	if (gpRenderMutex != SI_NULL)
+	{
+		siLockMutex(gpRenderMutex);
+	}
+
+	b8 hasEvictedGlyphs = pDrawList->hasEvictedGlyphs;
+
+	if (gpRenderMutex != SI_NULL)
+	{
+		siUnlockMutex(gpRenderMutex);
+	}
+
+	return !hasEvictedGlyphs;
+}
+
+void siDestroyDrawList(SiDrawList drawList)
+{
+	DRAW_LIST_VALIDATE(drawList);
+
+	if (gRecordingDrawList == drawList)
+	{
+		gRecordingDrawList = SI_DRAW_LIST_NULL;
+	}
+
+	// A pending frame replaying the list touches its glyph shelves, it is rendered before the context is handed over.
+	siAcquireRenderContext();
+	if (gSiCallbackHub.destroyDrawListFunction)
+	{
+		gSiCallbackHub.destroyDrawListFunction(drawList);
+	}
+
+	free(gDrawLists[drawList].glyphShelves.pShelves);
+	memset(&gDrawLists[drawList], 0, sizeof(SiDrawListData));
+	siReleaseRenderContext();
+}
+
 #ifdef SIMUI_USE_STB
 // =========================== Utils ===========================
 SiTexture readImageFile(const char* filePath)
 {
+	SiTexture cachedTexture = siLoadCachedTexture(filePath);
+	if (cachedTexture != SI_TEXTURE_NULL)
+	{
+		return cachedTexture;
+	}
+
 	int width, height, channels;
 	u8* data = stbi_load(filePath, &width, &height, &channels, 0);
 	if (!data)
@@ -170,6 +1657,7 @@ SiTexture readImageFile(const char* filePath)
 	}
 
 	SiTexture texture = siCreateTexture((u32)width, (u32)height, format, data);
+	siStoreCachedTexture(filePath, (u32)width, (u32)height, format, data);
 	stbi_image_free(data);
 	return texture;
 }
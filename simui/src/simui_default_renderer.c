@@ -1,5 +1,7 @@
 #if SIMUI_USE_DEFAULT_RENDERER
 #include "simui/simui.h"
+#include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 
 // clang-format off
@@ -9,8 +11,21 @@
 
 #include <stdio.h>
 
-#define SHADER_SOURCE_BUFFER_SIZE  2048
-#define MAX_UNIFORMS_PER_DRAW_CALL 16
+// Shader sources embedded into the library by cmake/EmbedShaders.cmake.
+extern const char gSiShader_instance_vert[];
+extern const char gSiShader_rounded_frag[];
+extern const char gSiShader_sim_vert[];
+extern const char gSiShader_sim_frag[];
+extern const char gSiShader_texture_vert[];
+extern const char gSiShader_texture_frag[];
+extern const char gSiShader_text_vert[];
+extern const char gSiShader_text_frag[];
+extern const char gSiShader_text_sdf_frag[];
+
+#define PROGRAM_BINARY_MAGIC	 0x47525053u ///< "SPRG" read as a little endian u32.
+#define PROGRAM_BINARY_PATH_SIZE 512
+#define PROGRAM_FNV_BASIS		 0xcbf29ce484222325ull
+#define PROGRAM_FNV_PRIME		 0x100000001b3ull
 
 #define GL_ASSERT(call)                                                                                                \
 	do                                                                                                                 \
@@ -24,94 +39,106 @@
 		}                                                                                                              \
 	} while (0);
 
-#define TEXTURE_VALIDATE(texture)                                                                                      \
-	do                                                                                                                 \
-	{                                                                                                                  \
-		if (texture >= MAX_TEXTURES)                                                                                   \
-		{                                                                                                              \
-			SI_ERROR_EXIT("Invalid texture handle.");                                                                  \
-		}                                                                                                              \
-                                                                                                                       \
-		if (!gTexturesHub[texture].isUsed)                                                                             \
-		{                                                                                                              \
-			SI_ERROR_EXIT("Texture handle not in use.");                                                               \
-		}                                                                                                              \
-	} while (0)
-
 /**
- * Uniform types for shaders.
+ * A linked shader program together with the locations of its uniforms, which are looked up once when the program is
+ * created. The last uploaded values are remembered so unchanged uniforms are never sent again.
  */
-typedef enum UniformType
+typedef struct ShaderProgram
 {
-	UNIFORM_TYPE_FLOAT,
-	UNIFORM_TYPE_VEC2,
-	UNIFORM_TYPE_VEC3,
-	UNIFORM_TYPE_VEC4,
-	UNIFORM_TYPE_INT,
-	UNIFORM_TYPE_IVEC2,
-	UNIFORM_TYPE_IVEC3,
-	UNIFORM_TYPE_IVEC4,
-	UNIFORM_TYPE_SAMPLER2D,
-} UniformType;
+	u32 program;			///< The OpenGL program object.
+	i32 windowSizeLocation; ///< Location of the `windowSize` uniform, -1 if the program does not use it.
+	i32 textureLocation;	///< Location of the `uTexture` sampler, -1 if the program does not use it.
+	i32 offsetLocation;		///< Location of the `uOffset` uniform, -1 if the program does not use it.
 
-typedef struct Sampler2D
-{
-	u32 textureUnit;
-	u32 textureId;
-} Sampler2D;
-
-/**
- * Union to hold different types of uniform values.
- */
-typedef union UniformValue {
-	f32		  floatValue;
-	f32		  vec2Value[2];
-	f32		  vec3Value[3];
-	f32		  vec4Value[4];
-	i32		  intValue;
-	i32		  ivec2Value[2];
-	i32		  ivec3Value[3];
-	i32		  ivec4Value[4];
-	Sampler2D sampler2DValue;
-} UniformValue;
+	SiVector2 windowSize; ///< The `windowSize` value currently stored in the program.
+	SiVector2 offset;	  ///< The `uOffset` value currently stored in the program.
+} ShaderProgram;
 
 /**
- * Structure to represent a uniform in a shader.
+ * Mirror of the OpenGL bindings the renderer changes, used to skip binds that would not change anything.
  */
-typedef struct Uniform
+typedef struct GLStateCache
 {
-	UniformType	 type;
-	UniformValue value;
-	i32			 location;
-} Uniform;
+	u32 program;	 ///< Currently used program object.
+	u32 vertexArray; ///< Currently bound vertex array object.
+	u32 arrayBuffer; ///< Buffer object bound to `GL_ARRAY_BUFFER`.
+	u32 texture;	 ///< Texture object bound to `GL_TEXTURE_2D` on texture unit 0.
+} GLStateCache;
 
 /**
  * Structure to hold draw call information.
  */
 typedef struct DrawCall
 {
-	Uniform uniforms[MAX_UNIFORMS_PER_DRAW_CALL]; ///< Array of uniforms for this draw call.
-	u32		uniformCount;						  ///< Number of uniforms.
-	u32		shader;								  ///< The shader program to use for this draw call.
-	u32		indexOffset;						  ///< The offset in the index buffer.
+	ShaderProgram* pShader;	  ///< The shader program to use for this draw call, `NULL` when replaying a draw list.
+	SiTexture	   texture;	  ///< The texture sampled by this draw call (or `SI_TEXTURE_NULL`).
+	u32			   textureId; ///< The OpenGL object of `texture`, resolved when the draw call is recorded.
+	u32			   firstQuad; ///< Index of the first quad of the frame drawn by this draw call.
+	u32			   quadCount; ///< The number of consecutive quads drawn by this draw call.
+	SiDrawList	   drawList;  ///< The draw list replayed by this draw call, or `SI_DRAW_LIST_NULL`.
+	SiVector2	   offset;	  ///< The offset `drawList` is replayed at.
 } DrawCall;
 
-#define MAX_TEXTURES   128
-#define MAX_RECTANGLES 1024
-#define MAX_VERTICES   (MAX_RECTANGLES * 4)
-#define MAX_INDICES	   (MAX_RECTANGLES * 6)
+#define INITIAL_QUAD_CAPACITY	   1024
+#define INITIAL_DRAW_CALL_CAPACITY 64
+#define VERTICES_PER_QUAD		   4
+#define INDICES_PER_QUAD		   6
+
+#define SKIPPED_FRAME_WAIT_SECONDS (1.0 / 60.0)
+
+#define UPLOAD_BUFFER_COUNT 3
 
-typedef struct SiTextureData
+/**
+ * The name of the OpenGL texture of `texture`, the data the default renderer keeps in the texture pool next to every
+ * slot.
+ */
+static u32* getTextureId(SiTexture texture)
 {
-	u32				width;
-	u32				height;
-	SiTextureFormat format;
-	u32				textureId;
+	return (u32*)siGetTextureSlotData(texture);
+}
 
-	b8 isUsed; ///< Flag to indicate if the texture slot is used.
-} SiTextureData;
+#ifdef SIMUI_USE_INSTANCED_PIPELINE
+/**
+ * Per-instance data of the instanced pipeline. Each rectangle is uploaded once and expanded into a quad by
+ * `shaders/instance.vert`, which reads the corner from `gl_VertexID` of the static quad index pattern.
+ */
+typedef struct RenderQuad
+{
+	f32 rect[4];   ///< Center x, center y, width and height of the rectangle.
+	u16 uvRect[4]; ///< Sprite `quadMin` and `quadMax` clamped to [0, 1], normalized by the vertex attribute.
+	u8	color[4];  ///< RGBA color, normalized to [0, 1] by the vertex attribute.
+	f32 style[2];  ///< Corner radius and border width, evaluated analytically by `shaders/rounded.frag`.
+} RenderQuad;
+#else
+/**
+ * Vertex structure for rendering.
+ */
+typedef struct RenderVertex
+{
+	f32 position[2];
+	f32 textureCoordinates[2];
+	u8	color[4]; ///< Per-vertex RGBA color, normalized to [0, 1] by the vertex attribute.
+} RenderVertex;
 
-static SiTextureData gTexturesHub[MAX_TEXTURES];
+/**
+ * The four corners of a rectangle, in the order expected by the static quad index pattern.
+ */
+typedef struct RenderQuad
+{
+	RenderVertex vertices[VERTICES_PER_QUAD];
+} RenderQuad;
+#endif // SIMUI_USE_INSTANCED_PIPELINE
+
+/**
+ * A `GL_PIXEL_UNPACK_BUFFER` of the texture update ring. `glTexSubImage2D` reads from it asynchronously, the fence
+ * tells whether the GPU is done with it before its storage is written again.
+ */
+typedef struct UploadBuffer
+{
+	u32	   buffer;	 ///< The buffer object, 0 until first used.
+	u64	   capacity; ///< Bytes of storage allocated for `buffer`.
+	GLsync fence;	 ///< Signaled once the last upload from `buffer` completed, `NULL` before the first one.
+} UploadBuffer;
 
 /**
  * Data structure to hold default renderer specific data.
@@ -121,40 +148,72 @@ typedef struct DefaultRendererData
 	GLFWwindow* pWindow; ///< Pointer to the GLFW window.
 
 	u32 vao; ///< Vertex Array Object.
-	u32 vbo; ///< Vertex Buffer Object.
-	u32 ebo; ///< Element Buffer Object.
+	u32 vbo; ///< Vertex Buffer Object, re-specified (orphaned) with the whole frame once per frame.
+	u32 ebo; ///< Element Buffer Object, holding the static quad index pattern.
+
+	u32 quadIndexCapacity; ///< Number of quads covered by the static index pattern inside `ebo`.
+
+	ShaderProgram simpleShader;	 ///< Shader program.
+	ShaderProgram textureShader; ///< Texture shader program.
+	ShaderProgram textShader;	 ///< Text shader program.
+	ShaderProgram textSdfShader; ///< Text shader program for signed distance field fonts.
 
-	u32 simpleShader;  ///< Shader program.
-	u32 textureShader; ///< Texture shader program.
-	u32 textShader;	   ///< Text shader program.
+	GLStateCache glState;	 ///< The OpenGL bindings currently in effect.
+	SiVector2	 windowSize; ///< Framebuffer size, queried once at the beginning of the frame.
 
-	DrawCall drawCalls[MAX_RECTANGLES]; ///< Array of draw calls.
-	u32		 drawCallCount;				///< Number of draw calls.
-	u32		 currentDrawCallIndex;		///< Current draw call index.
+	DrawCall* pDrawCalls;		 ///< Growable array of draw calls.
+	u32		  drawCallCount;	 ///< Number of draw calls.
+	u32		  drawCallCapacity; ///< Number of draw calls `pDrawCalls` can hold.
 
-	u32 bufferOffset; ///< Current buffer offset for dynamic vertex data.
-	u32 indexOffset;  ///< Current index offset for dynamic index data.
+	RenderQuad* pQuads;		  ///< CPU-side staging array of the frame's quads.
+	u32			quadCount;	  ///< Number of quads recorded in the current frame.
+	u32			quadCapacity; ///< Number of quads `pQuads` can hold.
+
+	u32		  retainedFramebuffer; ///< Framebuffer keeping the last frame for dirty region redraws, 0 until used.
+	u32		  retainedColorBuffer; ///< Color renderbuffer of `retainedFramebuffer`.
+	SiVector2 retainedSize;		   ///< The size `retainedColorBuffer` was allocated with.
+	b8		  hasDirtyRegion;	   ///< Whether the current frame is drawn into `retainedFramebuffer`.
+	SiVector4 dirtyRegion;		   ///< The area of the current frame to redraw, in drawing coordinates.
+
+	UploadBuffer uploadBuffers[UPLOAD_BUFFER_COUNT]; ///< Ring of staging buffers used by the texture updates.
+	u32			 nextUploadBuffer;					 ///< The buffer of the ring used by the next texture update.
+	SiTexture	 mappedTexture;						 ///< The texture of `siMapTextureRegion`, or `SI_TEXTURE_NULL`.
+	u32			 mappedRegion[4];					 ///< x, y, width and height of the region of `mappedTexture`.
 } DefaultRendererData;
 
 static DefaultRendererData gDefaultRendererData = {0};
 
+/**
+ * The geometry of a recorded draw list, uploaded once into a `GL_STATIC_DRAW` buffer with its own vertex array.
+ * Replaying the list issues its draw calls as they are, without touching the geometry.
+ */
+typedef struct RendererDrawList
+{
+	u32		  vao;				///< Vertex Array Object reading from `vbo`, 0 until the list is first recorded.
+	u32		  vbo;				///< Vertex Buffer Object holding the quads of the list.
+	DrawCall* pDrawCalls;		///< The batches of the list, `firstQuad` is relative to `vbo`.
+	u32		  drawCallCount;	///< Number of batches of the list.
+	u32		  drawCallCapacity;	///< Number of batches `pDrawCalls` can hold.
+} RendererDrawList;
+
+static RendererDrawList gRendererDrawLists[SI_MAX_DRAW_LISTS];
+
 static void		 siInitialize_DefaultRenderer();
 static void		 siPollEvents_DefaultRenderer();
 static void		 siBeginFrame_DefaultRenderer();
 static void		 siEndFrame_DefaultRenderer();
+static void		 siSkipFrame_DefaultRenderer();
+static void		 siSetDirtyRegion_DefaultRenderer(SiVector4 region);
+static void		 siMakeContextCurrent_DefaultRenderer(b8 isCurrent);
 static void		 siShutdown_DefaultRenderer();
 static void		 siDrawRectangle_DefaultRenderer(DrawRectangleParameter params, void* pRenderingData);
 static void		 siDrawText_DefaultRenderer(DrawTextParameter params, void* pRenderingData);
 static SiVector2 siGetWindowSize_DefaultRenderer(void* pRenderingData);
 
-/**
- * Vertex structure for rendering.
- */
-typedef struct RenderVertex
-{
-	f32 position[2];
-	f32 textureCoordinates[2];
-} RenderVertex;
+static void siDrawList_DefaultRenderer(DrawListParameter params, void* pRenderingData);
+static void siBeginDrawList_DefaultRenderer(SiDrawList drawList);
+static void siEndDrawList_DefaultRenderer(SiDrawList drawList);
+static void siDestroyDrawList_DefaultRenderer(SiDrawList drawList);
 
 void siConfigureCallbacks()
 {
@@ -164,19 +223,48 @@ void siConfigureCallbacks()
 	hub->pollEventsFunction	   = siPollEvents_DefaultRenderer;
 	hub->beginFrameFunction	   = siBeginFrame_DefaultRenderer;
 	hub->endFrameFunction	   = siEndFrame_DefaultRenderer;
+	hub->skipFrameFunction	   = siSkipFrame_DefaultRenderer;
 	hub->shutdownFunction	   = siShutdown_DefaultRenderer;
 	hub->getWindowSizeFunction = siGetWindowSize_DefaultRenderer;
 
+	hub->setDirtyRegionFunction		= siSetDirtyRegion_DefaultRenderer;
+	hub->makeContextCurrentFunction = siMakeContextCurrent_DefaultRenderer;
+
 	hub->drawRectangleFunction = siDrawRectangle_DefaultRenderer;
 	hub->drawTextFunction	   = siDrawText_DefaultRenderer;
+
+	hub->drawListFunction		 = siDrawList_DefaultRenderer;
+	hub->beginDrawListFunction	 = siBeginDrawList_DefaultRenderer;
+	hub->endDrawListFunction	 = siEndDrawList_DefaultRenderer;
+	hub->destroyDrawListFunction = siDestroyDrawList_DefaultRenderer;
 }
 
-static u32 createShaderFromSource(const char* vertexSourceFile, const char* fragmentSourceFile);
+static ShaderProgram createShaderFromSource(const char* vertexSource, const char* fragmentSource);
+static void			 deleteShaderProgram(ShaderProgram* pShader);
+static void*		 growArray(void* pArray, u32* pCapacity, u32 requiredCount, u32 elementSize);
+static void			 ensureQuadIndices(u32 quadCount);
+static void			 setupVertexArray(u32 vertexBuffer);
+static b8			 bindRetainedFramebuffer();
+
+static void bindShaderProgram(ShaderProgram* pShader);
+static void bindVertexArray(u32 vertexArray);
+static void bindArrayBuffer(u32 buffer);
+static void bindTexture(u32 textureId);
+
+static DrawCall* acquireDrawCall(ShaderProgram* pShader, SiTexture texture);
+static void		 pushQuad(DrawCall* pDrawCall, const DrawRectangleParameter* pParams);
+static void		 drawBatch(const DrawCall* pDrawCall, SiVector2 offset);
+
+#ifdef SIMUI_USE_INSTANCED_PIPELINE
+static void setInstanceAttributes(u32 firstInstance);
+#endif // SIMUI_USE_INSTANCED_PIPELINE
 
 static void siInitialize_DefaultRenderer()
 {
 	memset(&gDefaultRendererData, 0, sizeof(gDefaultRendererData));
-	memset(gTexturesHub, 0, sizeof(gTexturesHub));
+	gDefaultRendererData.mappedTexture = SI_TEXTURE_NULL;
+	siInitializeTexturePool(sizeof(u32));
+	memset(gRendererDrawLists, 0, sizeof(gRendererDrawLists));
 
 	if (!glfwInit())
 	{
@@ -203,45 +291,209 @@ static void siInitialize_DefaultRenderer()
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	gDefaultRendererData.simpleShader = createShaderFromSource(SI_STRINGIFY(SOURCE_PATH) "/shaders/sim.vert",
-															   SI_STRINGIFY(SOURCE_PATH) "/shaders/sim.frag");
-
-	gDefaultRendererData.textureShader = createShaderFromSource(SI_STRINGIFY(SOURCE_PATH) "/shaders/texture.vert",
-																SI_STRINGIFY(SOURCE_PATH) "/shaders/texture.frag");
+	// Every sampler reads from texture unit 0, so it is selected once for the lifetime of the context.
+	GL_ASSERT(glActiveTexture(GL_TEXTURE0));
+
+	// Single channel and RGB rows are not 4 byte aligned, glyph atlas regions in particular have arbitrary widths.
+	GL_ASSERT(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+#ifdef SIMUI_USE_INSTANCED_PIPELINE
+	gDefaultRendererData.simpleShader  = createShaderFromSource(gSiShader_instance_vert, gSiShader_rounded_frag);
+	gDefaultRendererData.textureShader = createShaderFromSource(gSiShader_instance_vert, gSiShader_texture_frag);
+	gDefaultRendererData.textShader	   = createShaderFromSource(gSiShader_instance_vert, gSiShader_text_frag);
+	gDefaultRendererData.textSdfShader = createShaderFromSource(gSiShader_instance_vert, gSiShader_text_sdf_frag);
+#else
+	gDefaultRendererData.simpleShader  = createShaderFromSource(gSiShader_sim_vert, gSiShader_sim_frag);
+	gDefaultRendererData.textureShader = createShaderFromSource(gSiShader_texture_vert, gSiShader_texture_frag);
+	gDefaultRendererData.textShader	   = createShaderFromSource(gSiShader_text_vert, gSiShader_text_frag);
+	gDefaultRendererData.textSdfShader = createShaderFromSource(gSiShader_text_vert, gSiShader_text_sdf_frag);
+#endif // SIMUI_USE_INSTANCED_PIPELINE
+
+	gDefaultRendererData.pQuads =
+		(RenderQuad*)growArray(NULL, &gDefaultRendererData.quadCapacity, INITIAL_QUAD_CAPACITY, sizeof(RenderQuad));
+	gDefaultRendererData.pDrawCalls = (DrawCall*)growArray(
+		NULL, &gDefaultRendererData.drawCallCapacity, INITIAL_DRAW_CALL_CAPACITY, sizeof(DrawCall));
 
-	gDefaultRendererData.textShader = createShaderFromSource(SI_STRINGIFY(SOURCE_PATH) "/shaders/text.vert",
-															 SI_STRINGIFY(SOURCE_PATH) "/shaders/text.frag");
+	GL_ASSERT(glGenVertexArrays(1, &gDefaultRendererData.vao));
+	bindVertexArray(gDefaultRendererData.vao);
 
 	GL_ASSERT(glGenBuffers(1, &gDefaultRendererData.vbo));
-	GL_ASSERT(glBindBuffer(GL_ARRAY_BUFFER, gDefaultRendererData.vbo));
-	GL_ASSERT(glBufferData(GL_ARRAY_BUFFER, sizeof(RenderVertex) * MAX_VERTICES, NULL, GL_DYNAMIC_DRAW));
-
 	GL_ASSERT(glGenBuffers(1, &gDefaultRendererData.ebo));
-	GL_ASSERT(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gDefaultRendererData.ebo));
-	GL_ASSERT(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(u32) * MAX_INDICES, NULL, GL_DYNAMIC_DRAW));
+	setupVertexArray(gDefaultRendererData.vbo);
+	ensureQuadIndices(INITIAL_QUAD_CAPACITY);
 
-	GL_ASSERT(glGenVertexArrays(1, &gDefaultRendererData.vao));
-	GL_ASSERT(glBindVertexArray(gDefaultRendererData.vao));
-	GL_ASSERT(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(RenderVertex), (void*)0));
-	GL_ASSERT(glEnableVertexAttribArray(0));
-	GL_ASSERT(glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(RenderVertex), (void*)(2 * sizeof(f32))));
-	GL_ASSERT(glEnableVertexAttribArray(1));
-
-	GL_ASSERT(glBindBuffer(GL_ARRAY_BUFFER, 0));
-	GL_ASSERT(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-	GL_ASSERT(glBindVertexArray(0));
+	bindVertexArray(0);
+	bindArrayBuffer(0);
 	gSiContext.pRenderingData = &gDefaultRendererData;
 }
 
-static u32 createShaderFromSource(const char* vertexSourceFile, const char* fragmentSourceFile)
+/**
+ * Header of a `.simprog` file, followed by the program binary returned by `glGetProgramBinary`.
+ */
+typedef struct ProgramBinaryHeader
+{
+	u32 magic;	///< `PROGRAM_BINARY_MAGIC`.
+	u32 format; ///< The binary format reported by the driver.
+	u64 key;	///< See `getProgramKey`.
+	u32 length; ///< Size in bytes of the binary.
+	u32 reserved;
+} ProgramBinaryHeader;
+
+static u64 hashString(u64 hash, const char* string)
+{
+	for (const char* pCharacter = string; pCharacter != SI_NULL && *pCharacter != '\0'; ++pCharacter)
+	{
+		hash ^= (u8)*pCharacter;
+		hash *= PROGRAM_FNV_PRIME;
+	}
+	return hash;
+}
+
+/**
+ * Key of a program binary: a binary is only valid for the driver which produced it, and only until the sources change.
+ */
+static u64 getProgramKey(const char* vertexSource, const char* fragmentSource)
+{
+	u64 key = PROGRAM_FNV_BASIS;
+	key		= hashString(key, (const char*)glGetString(GL_VENDOR));
+	key		= hashString(key, (const char*)glGetString(GL_RENDERER));
+	key		= hashString(key, (const char*)glGetString(GL_VERSION));
+	key		= hashString(key, vertexSource);
+	return hashString(key, fragmentSource);
+}
+
+/**
+ * Whether linked programs are cached, which needs `SiContext::shaderCacheDirectory`, the program binary entry points
+ * and a driver exposing at least one program binary format.
+ */
+static b8 canCacheProgramBinaries()
+{
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	if (gSiContext.shaderCacheDirectory == SI_NULL)
+	{
+		return SI_FALSE;
+	}
+
+	// The entry points are core since OpenGL 4.1 and come from ARB_get_program_binary before, the loader leaves them
+	// unset on older contexts without the extension.
+	if (glProgramBinary == SI_NULL || glGetProgramBinary == SI_NULL || glProgramParameteri == SI_NULL)
+	{
+		return SI_FALSE;
+	}
+
+	// Drivers without program binaries reject the query, which must not be fatal.
+	GLint formatCount = 0;
+	while (glGetError() != GL_NO_ERROR);
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	return glGetError() == GL_NO_ERROR && formatCount > 0 ? SI_TRUE : SI_FALSE;
+#else
+	return SI_FALSE;
+#endif // GL_PROGRAM_BINARY_LENGTH
+}
+
+static void getProgramBinaryPath(u64 key, char* path)
+{
+	siStringFormat(
+		path, PROGRAM_BINARY_PATH_SIZE, "%s/%016llx.simprog", gSiContext.shaderCacheDirectory, (unsigned long long)key);
+}
+
+/**
+ * Create a program from its cached binary.
+ *
+ * @return The linked program, or `0` when the binary is missing, stale or rejected by the driver, which happens after
+ *         driver updates even if the version string did not change.
+ */
+static u32 loadProgramBinary(u64 key)
+{
+	u32 program = 0u;
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	char path[PROGRAM_BINARY_PATH_SIZE];
+	getProgramBinaryPath(key, path);
+
+	SiMappedFile file;
+	if (!siMapFile(path, &file))
+	{
+		return 0u;
+	}
+
+	const ProgramBinaryHeader* pHeader = (const ProgramBinaryHeader*)file.pData;
+	if (file.size > sizeof(ProgramBinaryHeader) && pHeader->magic == PROGRAM_BINARY_MAGIC && pHeader->key == key &&
+		pHeader->length == file.size - sizeof(ProgramBinaryHeader))
+	{
+		program = glCreateProgram();
+		glProgramBinary(program, pHeader->format, file.pData + sizeof(ProgramBinaryHeader), (GLsizei)pHeader->length);
+
+		// An unknown format is an error rather than a failed link, both fall back to compiling the sources.
+		GLint isLinked = GL_FALSE;
+		while (glGetError() != GL_NO_ERROR);
+		GL_ASSERT(glGetProgramiv(program, GL_LINK_STATUS, &isLinked));
+		if (!isLinked)
+		{
+			GL_ASSERT(glDeleteProgram(program));
+			program = 0u;
+		}
+	}
+
+	siUnmapFile(&file);
+#else
+	(void)key;
+#endif // GL_PROGRAM_BINARY_LENGTH
+	return program;
+}
+
+static void storeProgramBinary(u32 program, u64 key)
+{
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	GLint length = 0;
+	GL_ASSERT(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+	if (length <= 0)
+	{
+		return;
+	}
+
+	u8* pBinary = (u8*)malloc((size_t)length);
+	if (pBinary == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate a program binary of %d bytes.", length);
+	}
+
+	ProgramBinaryHeader header = {0};
+	GLenum				format = 0;
+	GL_ASSERT(glGetProgramBinary(program, length, &length, &format, pBinary));
+	header.magic  = PROGRAM_BINARY_MAGIC;
+	header.format = (u32)format;
+	header.key	  = key;
+	header.length = (u32)length;
+
+	char path[PROGRAM_BINARY_PATH_SIZE];
+	getProgramBinaryPath(key, path);
+
+	if (!siWriteFileAtomic(path, &header, sizeof(ProgramBinaryHeader), pBinary, (u64)length))
+	{
+		siPrintWarning("Failed to write program binary file: %s", path);
+	}
+
+	free(pBinary);
+#else
+	(void)program;
+	(void)key;
+#endif // GL_PROGRAM_BINARY_LENGTH
+}
+
+static u32 compileShader(GLenum type, const char* source)
 {
-	char vertexShaderSource[SHADER_SOURCE_BUFFER_SIZE] = {0};
-	readFile(vertexSourceFile, vertexShaderSource, SHADER_SOURCE_BUFFER_SIZE);
-	const char* vertexShaderSourcePtr = vertexShaderSource;
+	u32 shader = glCreateShader(type);
+	GL_ASSERT(glShaderSource(shader, 1, &source, NULL));
+	GL_ASSERT(glCompileShader(shader));
+	return shader;
+}
 
-	u32 vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	GL_ASSERT(glShaderSource(vertexShader, 1, &vertexShaderSourcePtr, NULL));
-	GL_ASSERT(glCompileShader(vertexShader));
+/**
+ * Compile and link a program from its sources.
+ */
+static u32 linkProgram(const char* vertexSource, const char* fragmentSource, b8 isRetrievable)
+{
+	u32 vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
 
 	GLuint success;
 	GL_ASSERT(glGetShaderiv(vertexShader, GL_COMPILE_STATUS, (i32*)&success));
@@ -252,13 +504,7 @@ static u32 createShaderFromSource(const char* vertexSourceFile, const char* frag
 		SI_ERROR_EXIT("ERROR::SHADER::VERTEX::COMPILATION_FAILED\n%s\n", infoLog);
 	}
 
-	char fragShaderSource[SHADER_SOURCE_BUFFER_SIZE] = {0};
-	readFile(fragmentSourceFile, fragShaderSource, SHADER_SOURCE_BUFFER_SIZE);
-	const char* fragShaderSourcePtr = fragShaderSource;
-
-	u32 fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	GL_ASSERT(glShaderSource(fragmentShader, 1, &fragShaderSourcePtr, NULL));
-	GL_ASSERT(glCompileShader(fragmentShader));
+	u32 fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
 
 	GL_ASSERT(glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, (i32*)&success));
 	if (!success)
@@ -269,6 +515,14 @@ static u32 createShaderFromSource(const char* vertexSourceFile, const char* frag
 	}
 
 	u32 shaderProgram = glCreateProgram();
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	if (isRetrievable)
+	{
+		GL_ASSERT(glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+	}
+#else
+	(void)isRetrievable;
+#endif // GL_PROGRAM_BINARY_LENGTH
 	GL_ASSERT(glAttachShader(shaderProgram, vertexShader));
 	GL_ASSERT(glAttachShader(shaderProgram, fragmentShader));
 	GL_ASSERT(glLinkProgram(shaderProgram));
@@ -287,6 +541,56 @@ static u32 createShaderFromSource(const char* vertexSourceFile, const char* frag
 	return shaderProgram;
 }
 
+/**
+ * Create a program from its sources, or from its cached binary when `SiContext::shaderCacheDirectory` is set so that
+ * warm starts compile and link nothing.
+ */
+static ShaderProgram createShaderFromSource(const char* vertexSource, const char* fragmentSource)
+{
+	b8	isCached	  = canCacheProgramBinaries();
+	u64 key			  = isCached ? getProgramKey(vertexSource, fragmentSource) : 0u;
+	u32 shaderProgram = isCached ? loadProgramBinary(key) : 0u;
+	if (shaderProgram == 0u)
+	{
+		shaderProgram = linkProgram(vertexSource, fragmentSource, isCached);
+		if (isCached)
+		{
+			storeProgramBinary(shaderProgram, key);
+		}
+	}
+
+	ShaderProgram shader	  = {0};
+	shader.program			  = shaderProgram;
+	shader.windowSizeLocation = glGetUniformLocation(shaderProgram, "windowSize");
+	shader.textureLocation	  = glGetUniformLocation(shaderProgram, "uTexture");
+	shader.offsetLocation	  = glGetUniformLocation(shaderProgram, "offset");
+
+	if (shader.windowSizeLocation == -1)
+	{
+		siPrintWarning("SIMUI: Failed to get uniform location for 'windowSize'.");
+	}
+
+	// The sampler always reads from texture unit 0, so it only has to be assigned once.
+	if (shader.textureLocation != -1)
+	{
+		bindShaderProgram(&shader);
+		GL_ASSERT(glUniform1i(shader.textureLocation, 0));
+	}
+
+	return shader;
+}
+
+static void deleteShaderProgram(ShaderProgram* pShader)
+{
+	if (gDefaultRendererData.glState.program == pShader->program)
+	{
+		gDefaultRendererData.glState.program = 0u;
+	}
+
+	GL_ASSERT(glDeleteProgram(pShader->program));
+	memset(pShader, 0, sizeof(ShaderProgram));
+}
+
 static void siPollEvents_DefaultRenderer()
 {
 	glfwPollEvents();
@@ -297,264 +601,686 @@ static void siPollEvents_DefaultRenderer()
 	}
 }
 
+static void siSetDirtyRegion_DefaultRenderer(SiVector4 region)
+{
+	gDefaultRendererData.hasDirtyRegion = SI_TRUE;
+	gDefaultRendererData.dirtyRegion	= region;
+}
+
+static void siMakeContextCurrent_DefaultRenderer(b8 isCurrent)
+{
+	glfwMakeContextCurrent(isCurrent ? gDefaultRendererData.pWindow : NULL);
+}
+
 static void siBeginFrame_DefaultRenderer()
 {
+	// The size is sampled by `siRender`, GLFW can not be queried from the render thread.
+	gDefaultRendererData.windowSize = gSiContext.renderWindowSize;
+
+	if (gDefaultRendererData.hasDirtyRegion && bindRetainedFramebuffer())
+	{
+		// Drawing coordinates span twice the framebuffer size (see the vertex shaders). The scissor box is rounded
+		// outwards to whole pixels and clamped to the framebuffer.
+		SiVector2 size	 = gDefaultRendererData.windowSize;
+		SiVector4 region = gDefaultRendererData.dirtyRegion;
+		f32		  left	 = region.x > 0.0f ? region.x / 2.0f : 0.0f;
+		f32		  bottom = region.y > 0.0f ? region.y / 2.0f : 0.0f;
+		f32		  right	 = region.z / 2.0f < size.x ? region.z / 2.0f : size.x;
+		f32		  top	 = region.w / 2.0f < size.y ? region.w / 2.0f : size.y;
+
+		i32 scissorLeft	  = (i32)left;
+		i32 scissorBottom = (i32)bottom;
+		i32 scissorRight  = (i32)right + ((f32)(i32)right < right ? 1 : 0);
+		i32 scissorTop	  = (i32)top + ((f32)(i32)top < top ? 1 : 0);
+
+		// The clear only touches the scissor box, the pixels outside of it are kept from the last frame.
+		GL_ASSERT(glEnable(GL_SCISSOR_TEST));
+		GL_ASSERT(glScissor(scissorLeft,
+							scissorBottom,
+							scissorRight > scissorLeft ? scissorRight - scissorLeft : 0,
+							scissorTop > scissorBottom ? scissorTop - scissorBottom : 0));
+	}
+	else
+	{
+		gDefaultRendererData.hasDirtyRegion = SI_FALSE;
+	}
+
 	GL_ASSERT(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
 	GL_ASSERT(glClear(GL_COLOR_BUFFER_BIT));
 }
 
 static void siEndFrame_DefaultRenderer()
 {
+	if (gDefaultRendererData.quadCount > 0u)
+	{
+		bindVertexArray(gDefaultRendererData.vao);
+#ifndef SIMUI_USE_INSTANCED_PIPELINE
+		ensureQuadIndices(gDefaultRendererData.quadCount);
+#endif // SIMUI_USE_INSTANCED_PIPELINE
+
+		// Re-specifying the whole store orphans the buffer the previous frame may still be reading, so the driver
+		// hands out fresh memory instead of synchronizing, and the frame is uploaded with a single call.
+		bindArrayBuffer(gDefaultRendererData.vbo);
+		GL_ASSERT(glBufferData(GL_ARRAY_BUFFER,
+							   sizeof(RenderQuad) * gDefaultRendererData.quadCount,
+							   gDefaultRendererData.pQuads,
+							   GL_STREAM_DRAW));
+	}
+
 	for (u32 drawCallIndex = 0u; drawCallIndex < gDefaultRendererData.drawCallCount; ++drawCallIndex)
 	{
-		DrawCall* pDrawCall = &gDefaultRendererData.drawCalls[drawCallIndex];
-		GL_ASSERT(glUseProgram(pDrawCall->shader));
-		GL_ASSERT(glBindVertexArray(gDefaultRendererData.vao));
-		GL_ASSERT(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gDefaultRendererData.ebo));
+		DrawCall* pDrawCall = &gDefaultRendererData.pDrawCalls[drawCallIndex];
 
-		// Set uniforms
-		for (u32 uniformIndex = 0u; uniformIndex < pDrawCall->uniformCount; ++uniformIndex)
+		if (pDrawCall->drawList != SI_DRAW_LIST_NULL)
 		{
-			Uniform* pUniform = &pDrawCall->uniforms[uniformIndex];
-			switch (pUniform->type)
+			RendererDrawList* pDrawList = &gRendererDrawLists[pDrawCall->drawList];
+			bindVertexArray(pDrawList->vao);
+			bindArrayBuffer(pDrawList->vbo);
+
+			for (u32 batchIndex = 0u; batchIndex < pDrawList->drawCallCount; ++batchIndex)
 			{
-			case UNIFORM_TYPE_FLOAT:
-				GL_ASSERT(glUniform1f(pUniform->location, pUniform->value.floatValue));
-				break;
-			case UNIFORM_TYPE_VEC2:
-				GL_ASSERT(glUniform2fv(pUniform->location, 1, pUniform->value.vec2Value));
-				break;
-			case UNIFORM_TYPE_VEC3:
-				GL_ASSERT(glUniform3fv(pUniform->location, 1, pUniform->value.vec3Value));
-				break;
-			case UNIFORM_TYPE_VEC4:
-				GL_ASSERT(glUniform4fv(pUniform->location, 1, pUniform->value.vec4Value));
-				break;
-			case UNIFORM_TYPE_INT:
-				GL_ASSERT(glUniform1i(pUniform->location, pUniform->value.intValue));
-				break;
-			case UNIFORM_TYPE_IVEC2:
-				GL_ASSERT(glUniform2iv(pUniform->location, 1, pUniform->value.ivec2Value));
-				break;
-			case UNIFORM_TYPE_IVEC3:
-				GL_ASSERT(glUniform3iv(pUniform->location, 1, pUniform->value.ivec3Value));
-				break;
-			case UNIFORM_TYPE_IVEC4:
-				GL_ASSERT(glUniform4iv(pUniform->location, 1, pUniform->value.ivec4Value));
-				break;
-			case UNIFORM_TYPE_SAMPLER2D:
-				GL_ASSERT(glActiveTexture(GL_TEXTURE0 + pUniform->value.sampler2DValue.textureUnit));
-				GL_ASSERT(glBindTexture(GL_TEXTURE_2D, pUniform->value.sampler2DValue.textureId));
-				GL_ASSERT(glUniform1i(pUniform->location, pUniform->value.sampler2DValue.textureUnit));
-				break;
-			default:
-				SI_ERROR_EXIT("Unknown uniform type.");
+				// The OpenGL object of a texture destroyed since the recording is deleted or already reused.
+				const DrawCall* pBatch = &pDrawList->pDrawCalls[batchIndex];
+				if (pBatch->texture != SI_TEXTURE_NULL && !siIsTextureAlive(pBatch->texture))
+				{
+					continue;
+				}
+
+				drawBatch(pBatch, pDrawCall->offset);
 			}
+			continue;
 		}
 
-		GL_ASSERT(
-			glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(uintptr_t)(pDrawCall->indexOffset * sizeof(u32))));
+		// A replayed draw list may have switched to its own buffers.
+		bindVertexArray(gDefaultRendererData.vao);
+		bindArrayBuffer(gDefaultRendererData.vbo);
+		drawBatch(pDrawCall, (SiVector2){0.0f, 0.0f});
+	}
+
+	if (gDefaultRendererData.hasDirtyRegion)
+	{
+		// The back buffer content is undefined after a swap, the whole retained frame is copied to it.
+		i32 width  = (i32)gDefaultRendererData.retainedSize.x;
+		i32 height = (i32)gDefaultRendererData.retainedSize.y;
+		GL_ASSERT(glDisable(GL_SCISSOR_TEST));
+		GL_ASSERT(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0));
+		GL_ASSERT(glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+		GL_ASSERT(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		gDefaultRendererData.hasDirtyRegion = SI_FALSE;
 	}
 
 	GL_ASSERT(glfwSwapBuffers(gDefaultRendererData.pWindow));
 
 	// Reset for next frame
 	{
-		gDefaultRendererData.drawCallCount		  = 0u;
-		gDefaultRendererData.currentDrawCallIndex = 0u;
-		gDefaultRendererData.bufferOffset		  = 0u;
-		gDefaultRendererData.indexOffset		  = 0u;
+		gDefaultRendererData.drawCallCount = 0u;
+		gDefaultRendererData.quadCount	   = 0u;
+	}
+}
+
+static void siSkipFrame_DefaultRenderer()
+{
+	// The back buffer was not redrawn, so it is not swapped and the window keeps the last presented frame. With no
+	// swap to pace the loop, it sleeps until an input event arrives or a frame interval passes. Events can only be
+	// waited for on the main thread, the render thread sleeps the interval instead.
+	if (gSiContext.useRenderThread)
+	{
+		siSleep(SKIPPED_FRAME_WAIT_SECONDS);
+	}
+	else
+	{
+		glfwWaitEventsTimeout(SKIPPED_FRAME_WAIT_SECONDS);
 	}
 }
 
 static void siShutdown_DefaultRenderer()
 {
-	for (u32 textureIndex = 0u; textureIndex < MAX_TEXTURES; ++textureIndex)
+	siShutdownTexturePool();
+
+	for (u32 bufferIndex = 0u; bufferIndex < UPLOAD_BUFFER_COUNT; ++bufferIndex)
 	{
-		if (gTexturesHub[textureIndex].isUsed)
+		UploadBuffer* pUploadBuffer = &gDefaultRendererData.uploadBuffers[bufferIndex];
+		if (pUploadBuffer->fence != NULL)
 		{
-			siDestroyTexture((SiTexture)textureIndex);
+			GL_ASSERT(glDeleteSync(pUploadBuffer->fence));
+		}
+		if (pUploadBuffer->buffer != 0u)
+		{
+			GL_ASSERT(glDeleteBuffers(1, &pUploadBuffer->buffer));
 		}
 	}
 
 	GL_ASSERT(glDeleteBuffers(1, &gDefaultRendererData.vbo));
 	GL_ASSERT(glDeleteBuffers(1, &gDefaultRendererData.ebo));
 	GL_ASSERT(glDeleteVertexArrays(1, &gDefaultRendererData.vao));
-	GL_ASSERT(glDeleteProgram(gDefaultRendererData.simpleShader));
-	GL_ASSERT(glDeleteProgram(gDefaultRendererData.textureShader));
+
+	if (gDefaultRendererData.retainedFramebuffer != 0u)
+	{
+		GL_ASSERT(glDeleteFramebuffers(1, &gDefaultRendererData.retainedFramebuffer));
+		GL_ASSERT(glDeleteRenderbuffers(1, &gDefaultRendererData.retainedColorBuffer));
+	}
+	deleteShaderProgram(&gDefaultRendererData.simpleShader);
+	deleteShaderProgram(&gDefaultRendererData.textureShader);
+	deleteShaderProgram(&gDefaultRendererData.textShader);
+	deleteShaderProgram(&gDefaultRendererData.textSdfShader);
+
+	free(gDefaultRendererData.pQuads);
+	free(gDefaultRendererData.pDrawCalls);
 
 	GL_ASSERT(glfwDestroyWindow(gDefaultRendererData.pWindow));
 	glfwTerminate();
 }
 
-static void addVec2Uniform(DrawCall* pDrawCall, const char* name, SiVector2 vec);
-static void addVec4Uniform(DrawCall* pDrawCall, const char* name, SiVector4 vec);
-static void addSamplerUniform(DrawCall* pDrawCall, const char* name, u32 textureUnit, u32 texture);
-
 static void siDrawRectangle_DefaultRenderer(DrawRectangleParameter params, void* pRenderingData)
 {
-	DrawCall* pDrawCall = &gDefaultRendererData.drawCalls[gDefaultRendererData.drawCallCount++];
-	memset(pDrawCall, 0, sizeof(DrawCall));
-	pDrawCall->indexOffset = gDefaultRendererData.indexOffset;
+	ShaderProgram* pShader = NULL;
 
 	if (pRenderingData == NULL)
 	{
 		if (params.sprite.texture != SI_TEXTURE_NULL)
 		{
-			pDrawCall->shader = gDefaultRendererData.textureShader;
+			pShader = &gDefaultRendererData.textureShader;
 		}
 		else
 		{
-			pDrawCall->shader = gDefaultRendererData.simpleShader;
+			pShader = &gDefaultRendererData.simpleShader;
 		}
 	}
 	else
 	{
-		pDrawCall->shader = *(u32*)pRenderingData;
+		pShader = (ShaderProgram*)pRenderingData;
 	}
 
-	GL_ASSERT(glUseProgram(pDrawCall->shader));
+#ifndef SIMUI_USE_INSTANCED_PIPELINE
+	// Without the instanced pipeline the border is tessellated into four edge quads and the corners stay square.
+	if (params.borderWidth > 0.0f && params.sprite.texture == SI_TEXTURE_NULL)
+	{
+		f32 border = params.borderWidth;
+		if (border * 2.0f < params.width && border * 2.0f < params.height)
+		{
+			DrawCall* pDrawCall = acquireDrawCall(pShader, SI_TEXTURE_NULL);
+
+			DrawRectangleParameter edge = params;
+			edge.borderWidth			= 0.0f;
+
+			DrawRectangleParameter edges[4] = {edge, edge, edge, edge};
+			edges[0].y						= params.y - params.height / 2.0f + border / 2.0f; // Bottom
+			edges[0].height					= border;
+			edges[1].y						= params.y + params.height / 2.0f - border / 2.0f; // Top
+			edges[1].height					= border;
+			edges[2].x						= params.x - params.width / 2.0f + border / 2.0f; // Left
+			edges[2].width					= border;
+			edges[2].height					= params.height - border * 2.0f;
+			edges[3].x						= params.x + params.width / 2.0f - border / 2.0f; // Right
+			edges[3].width					= border;
+			edges[3].height					= params.height - border * 2.0f;
+
+			for (u32 edgeIndex = 0u; edgeIndex < 4u; ++edgeIndex)
+			{
+				pushQuad(pDrawCall, &edges[edgeIndex]);
+			}
+			return;
+		}
+	}
+#endif // SIMUI_USE_INSTANCED_PIPELINE
 
-	addVec2Uniform(pDrawCall, "windowSize", siGetWindowSize_DefaultRenderer(&gDefaultRendererData));
-	addVec4Uniform(
-		pDrawCall,
-		"uColor",
-		(SiVector4){
-			params.color.r / 255.0f, params.color.g / 255.0f, params.color.b / 255.0f, params.color.a / 255.0f});
+	DrawCall* pDrawCall = acquireDrawCall(pShader, params.sprite.texture);
+	pushQuad(pDrawCall, &params);
+}
 
-	if (params.sprite.texture != SI_TEXTURE_NULL)
+/**
+ * Returns the draw call the next quad must be appended to. Consecutive quads sharing the same shader and texture are
+ * merged into the previous draw call, so the painter's order is kept while the number of draw calls only grows with
+ * the number of state changes.
+ */
+static DrawCall* acquireDrawCall(ShaderProgram* pShader, SiTexture texture)
+{
+	if (gDefaultRendererData.drawCallCount > 0u)
 	{
-		addSamplerUniform(pDrawCall, "uTexture", 0, params.sprite.texture);
+		DrawCall* pLastDrawCall = &gDefaultRendererData.pDrawCalls[gDefaultRendererData.drawCallCount - 1u];
+		if (pLastDrawCall->pShader == pShader && pLastDrawCall->texture == texture)
+		{
+			return pLastDrawCall;
+		}
 	}
 
-	GL_ASSERT(glBindBuffer(GL_ARRAY_BUFFER, gDefaultRendererData.vbo));
+	gDefaultRendererData.pDrawCalls = (DrawCall*)growArray(gDefaultRendererData.pDrawCalls,
+														   &gDefaultRendererData.drawCallCapacity,
+														   gDefaultRendererData.drawCallCount + 1u,
+														   sizeof(DrawCall));
+
+	DrawCall* pDrawCall = &gDefaultRendererData.pDrawCalls[gDefaultRendererData.drawCallCount++];
+	memset(pDrawCall, 0, sizeof(DrawCall));
+	pDrawCall->pShader	 = pShader;
+	pDrawCall->texture	 = texture;
+	pDrawCall->firstQuad = gDefaultRendererData.quadCount;
+	pDrawCall->drawList	 = SI_DRAW_LIST_NULL;
+
+	if (texture != SI_TEXTURE_NULL)
+	{
+		siValidateTexture(texture);
+		pDrawCall->textureId = *getTextureId(texture);
+	}
 
-	f32 x	   = params.x;
-	f32 y	   = params.y;
-	f32 width  = params.width;
-	f32 height = params.height;
+	return pDrawCall;
+}
 
-	SiVector2 bottomLeftTexCoord  = {0.0f, 1.0f};
-	SiVector2 bottomRightTexCoord = {1.0f, 1.0f};
-	SiVector2 topRightTexCoord	  = {1.0f, 0.0f};
-	SiVector2 topLeftTexCoord	  = {0.0f, 0.0f};
+#ifdef SIMUI_USE_INSTANCED_PIPELINE
+/**
+ * Quantize a texture coordinate to the normalized 16 bits of `RenderQuad::uvRect`. The instanced pipeline only carries
+ * coordinates in [0, 1], coordinates outside are clamped instead of wrapping around.
+ */
+static u16 quantizeTexCoord(f32 coordinate)
+{
+	f32 value = coordinate * 65535.0f + 0.5f;
+	return value <= 0.0f ? 0u : (value >= 65535.0f ? 65535u : (u16)value);
+}
+#endif // SIMUI_USE_INSTANCED_PIPELINE
 
-	SiSprite* pSprite = &params.sprite;
+/**
+ * Appends the quad of `pParams` to the frame's staging array and to `pDrawCall`, which must be the last draw call.
+ */
+static void pushQuad(DrawCall* pDrawCall, const DrawRectangleParameter* pParams)
+{
+	gDefaultRendererData.pQuads = (RenderQuad*)growArray(gDefaultRendererData.pQuads,
+														 &gDefaultRendererData.quadCapacity,
+														 gDefaultRendererData.quadCount + 1u,
+														 sizeof(RenderQuad));
+
+	RenderQuad*		pQuad	= &gDefaultRendererData.pQuads[gDefaultRendererData.quadCount++];
+	const SiSprite* pSprite = &pParams->sprite;
+	const SiColor*	pColor	= &pParams->color;
+
+#ifdef SIMUI_USE_INSTANCED_PIPELINE
+	pQuad->rect[0]	 = pParams->x;
+	pQuad->rect[1]	 = pParams->y;
+	pQuad->rect[2]	 = pParams->width;
+	pQuad->rect[3]	 = pParams->height;
+	pQuad->uvRect[0] = quantizeTexCoord(pSprite->quadMin.x);
+	pQuad->uvRect[1] = quantizeTexCoord(pSprite->quadMin.y);
+	pQuad->uvRect[2] = quantizeTexCoord(pSprite->quadMax.x);
+	pQuad->uvRect[3] = quantizeTexCoord(pSprite->quadMax.y);
+	pQuad->color[0]	 = pColor->r;
+	pQuad->color[1]	 = pColor->g;
+	pQuad->color[2]	 = pColor->b;
+	pQuad->color[3]	 = pColor->a;
+	pQuad->style[0]	 = pParams->cornerRadius;
+	pQuad->style[1]	 = pParams->borderWidth;
+#else
+	f32 x	   = pParams->x;
+	f32 y	   = pParams->y;
+	f32 width  = pParams->width;
+	f32 height = pParams->height;
 
 	// clang-format off
-	RenderVertex vertices[] = {
-		{{x - width / 2.0f, y - height / 2.0f}, {pSprite->quadMin.x, pSprite->quadMax.y}}, // Bottom-left
-		{{x + width / 2.0f, y - height / 2.0f}, {pSprite->quadMax.x, pSprite->quadMax.y}}, // Bottom-right
-		{{x + width / 2.0f, y + height / 2.0f}, {pSprite->quadMax.x, pSprite->quadMin.y}}, // Top-right
-		{{x - width / 2.0f, y + height / 2.0f}, {pSprite->quadMin.x, pSprite->quadMin.y}}, // Top-left
+	RenderVertex vertices[VERTICES_PER_QUAD] = {
+		{{x - width / 2.0f, y - height / 2.0f}, {pSprite->quadMin.x, pSprite->quadMax.y}, {pColor->r, pColor->g, pColor->b, pColor->a}}, // Bottom-left
+		{{x + width / 2.0f, y - height / 2.0f}, {pSprite->quadMax.x, pSprite->quadMax.y}, {pColor->r, pColor->g, pColor->b, pColor->a}}, // Bottom-right
+		{{x + width / 2.0f, y + height / 2.0f}, {pSprite->quadMax.x, pSprite->quadMin.y}, {pColor->r, pColor->g, pColor->b, pColor->a}}, // Top-right
+		{{x - width / 2.0f, y + height / 2.0f}, {pSprite->quadMin.x, pSprite->quadMin.y}, {pColor->r, pColor->g, pColor->b, pColor->a}}, // Top-left
 	};
 	// clang-format on
 
-	u32 verticiesCount = sizeof(vertices) / sizeof(RenderVertex);
+	memcpy(pQuad->vertices, vertices, sizeof(vertices));
+#endif // SIMUI_USE_INSTANCED_PIPELINE
 
-	GL_ASSERT(glBufferSubData(GL_ARRAY_BUFFER,
-							  gDefaultRendererData.bufferOffset * sizeof(RenderVertex),
-							  sizeof(RenderVertex) * verticiesCount,
-							  vertices));
+	pDrawCall->quadCount++;
+}
 
-	u32 indices[] = {
-		gDefaultRendererData.bufferOffset + 0,
-		gDefaultRendererData.bufferOffset + 1,
-		gDefaultRendererData.bufferOffset + 2,
-		gDefaultRendererData.bufferOffset + 2,
-		gDefaultRendererData.bufferOffset + 3,
-		gDefaultRendererData.bufferOffset + 0,
-	};
+/**
+ * A text being drawn by `siDrawText_DefaultRenderer`, handed to `pushGlyphQuad` for each of its glyphs.
+ */
+typedef struct GlyphQuads
+{
+	ShaderProgram*		   pShader; ///< `textShader` or `textSdfShader`, depending on the rasterization of the font.
+	DrawRectangleParameter params;	///< The color of the text, the rectangle and sprite are set per glyph.
+} GlyphQuads;
 
-	u32 indicesCount = sizeof(indices) / sizeof(u32);
+static void pushGlyphQuad(const SiGlyph* pGlyph, SiVector2 center, void* pUserData)
+{
+	GlyphQuads* pQuads			  = (GlyphQuads*)pUserData;
+	pQuads->params.x			  = center.x;
+	pQuads->params.y			  = center.y;
+	pQuads->params.width		  = pGlyph->size.x;
+	pQuads->params.height		  = pGlyph->size.y;
+	pQuads->params.sprite.texture = pGlyph->texture;
+	pQuads->params.sprite.quadMin = pGlyph->quadMin;
+	pQuads->params.sprite.quadMax = pGlyph->quadMax;
+
+	// Glyphs can live on different atlas pages, consecutive glyphs of the same page still share a draw call.
+	pushQuad(acquireDrawCall(pQuads->pShader, pGlyph->texture), &pQuads->params);
+}
 
-	GL_ASSERT(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gDefaultRendererData.ebo));
-	GL_ASSERT(glBufferSubData(
-		GL_ELEMENT_ARRAY_BUFFER, gDefaultRendererData.indexOffset * sizeof(u32), sizeof(u32) * indicesCount, indices));
+static void siDrawText_DefaultRenderer(DrawTextParameter params, void* pRenderingData)
+{
+	SiFont* pFont = params.pFont;
+
+	ShaderProgram* pShader = pFont->rasterization == SI_FONT_RASTERIZATION_SDF ? &gDefaultRendererData.textSdfShader
+																			   : &gDefaultRendererData.textShader;
+
+	GlyphQuads quads   = {};
+	quads.pShader	   = pShader;
+	quads.params.color = params.color;
 
-	gDefaultRendererData.bufferOffset += verticiesCount;
-	gDefaultRendererData.indexOffset += indicesCount;
+	siLayoutText(pFont, params.x, params.y, params.text, pushGlyphQuad, &quads);
 }
 
-static void siDrawText_DefaultRenderer(DrawTextParameter params, void* pRenderingData)
+/**
+ * Issues the draw of a single batch, with every quad moved by `offset`. The vertex array holding the quads of the
+ * batch must be bound, along with its buffer for the instanced pipeline.
+ */
+static void drawBatch(const DrawCall* pDrawCall, SiVector2 offset)
 {
-	// Text rendering not implemented in default renderer.
-	u32 charactersCount = strlen(params.text);
-	f32 currentOffsetX	= params.x;
+	ShaderProgram* pShader = pDrawCall->pShader;
+	bindShaderProgram(pShader);
 
-	f32 xSpacing = 2.0f; // You can adjust spacing between characters here
+	SiVector2 windowSize = gDefaultRendererData.windowSize;
+	if (pShader->windowSize.x != windowSize.x || pShader->windowSize.y != windowSize.y)
+	{
+		GL_ASSERT(glUniform2f(pShader->windowSizeLocation, windowSize.x, windowSize.y));
+		pShader->windowSize = windowSize;
+	}
 
-	for (u32 i = 0; i < charactersCount; ++i)
+	if (pShader->offset.x != offset.x || pShader->offset.y != offset.y)
 	{
-		DrawCall* pDrawCall = &gDefaultRendererData.drawCalls[gDefaultRendererData.drawCallCount++];
-		memset(pDrawCall, 0, sizeof(DrawCall));
+		GL_ASSERT(glUniform2f(pShader->offsetLocation, offset.x, offset.y));
+		pShader->offset = offset;
+	}
+
+	if (pDrawCall->texture != SI_TEXTURE_NULL)
+	{
+		bindTexture(pDrawCall->textureId);
+	}
+
+#ifdef SIMUI_USE_INSTANCED_PIPELINE
+	// OpenGL 3.3 has no base instance, so the instance attributes are re-pointed at the batch instead.
+	setInstanceAttributes(pDrawCall->firstQuad);
+	GL_ASSERT(glDrawElementsInstanced(GL_TRIANGLES, INDICES_PER_QUAD, GL_UNSIGNED_INT, NULL, pDrawCall->quadCount));
+#else
+	GL_ASSERT(glDrawElements(GL_TRIANGLES,
+							 pDrawCall->quadCount * INDICES_PER_QUAD,
+							 GL_UNSIGNED_INT,
+							 (void*)(uintptr_t)(pDrawCall->firstQuad * INDICES_PER_QUAD * sizeof(u32))));
+#endif // SIMUI_USE_INSTANCED_PIPELINE
+}
+
+static void siDrawList_DefaultRenderer(DrawListParameter params, void* pRenderingData)
+{
+	if (gRendererDrawLists[params.drawList].drawCallCount == 0u)
+	{
+		return;
+	}
+
+	gDefaultRendererData.pDrawCalls = (DrawCall*)growArray(gDefaultRendererData.pDrawCalls,
+														   &gDefaultRendererData.drawCallCapacity,
+														   gDefaultRendererData.drawCallCount + 1u,
+														   sizeof(DrawCall));
 
-		SiSprite  charSprite = siGetFontSprite(params.pFont, params.text[i]);
-		SiVector2 spriteSize = siGetSpriteSize(charSprite);
+	// The replay has no shader of its own, so the quads drawn after it never merge into it.
+	DrawCall* pDrawCall = &gDefaultRendererData.pDrawCalls[gDefaultRendererData.drawCallCount++];
+	memset(pDrawCall, 0, sizeof(DrawCall));
+	pDrawCall->texture	= SI_TEXTURE_NULL;
+	pDrawCall->drawList = params.drawList;
+	pDrawCall->offset	= (SiVector2){params.offsetX, params.offsetY};
+}
+
+static void siBeginDrawList_DefaultRenderer(SiDrawList drawList)
+{
+	// The primitives of the list are captured by the frame arrays, which are empty outside of `siRender`.
+	if (gDefaultRendererData.quadCount != 0u || gDefaultRendererData.drawCallCount != 0u)
+	{
+		SI_ERROR_EXIT("Draw lists must be recorded outside of siRender.");
+	}
+}
+
+static void siEndDrawList_DefaultRenderer(SiDrawList drawList)
+{
+	RendererDrawList* pDrawList = &gRendererDrawLists[drawList];
+
+	if (pDrawList->vao == 0u)
+	{
+		GL_ASSERT(glGenVertexArrays(1, &pDrawList->vao));
+		GL_ASSERT(glGenBuffers(1, &pDrawList->vbo));
+		bindVertexArray(pDrawList->vao);
+		setupVertexArray(pDrawList->vbo);
+	}
+	else
+	{
+		bindVertexArray(pDrawList->vao);
+		bindArrayBuffer(pDrawList->vbo);
+	}
+
+#ifndef SIMUI_USE_INSTANCED_PIPELINE
+	ensureQuadIndices(gDefaultRendererData.quadCount);
+#endif // SIMUI_USE_INSTANCED_PIPELINE
+
+	// Uploaded once and read every frame until the list is recorded again.
+	GL_ASSERT(glBufferData(GL_ARRAY_BUFFER,
+						   sizeof(RenderQuad) * gDefaultRendererData.quadCount,
+						   gDefaultRendererData.pQuads,
+						   GL_STATIC_DRAW));
+
+	pDrawList->pDrawCalls = (DrawCall*)growArray(
+		pDrawList->pDrawCalls, &pDrawList->drawCallCapacity, gDefaultRendererData.drawCallCount, sizeof(DrawCall));
+	if (gDefaultRendererData.drawCallCount > 0u)
+	{
+		memcpy(pDrawList->pDrawCalls,
+			   gDefaultRendererData.pDrawCalls,
+			   sizeof(DrawCall) * gDefaultRendererData.drawCallCount);
+	}
+	pDrawList->drawCallCount = gDefaultRendererData.drawCallCount;
+
+	gDefaultRendererData.drawCallCount = 0u;
+	gDefaultRendererData.quadCount	   = 0u;
+}
+
+static void siDestroyDrawList_DefaultRenderer(SiDrawList drawList)
+{
+	RendererDrawList* pDrawList = &gRendererDrawLists[drawList];
+
+	if (pDrawList->vao != 0u)
+	{
+		if (gDefaultRendererData.glState.vertexArray == pDrawList->vao)
+		{
+			gDefaultRendererData.glState.vertexArray = 0u;
+		}
+
+		if (gDefaultRendererData.glState.arrayBuffer == pDrawList->vbo)
+		{
+			gDefaultRendererData.glState.arrayBuffer = 0u;
+		}
+
+		GL_ASSERT(glDeleteVertexArrays(1, &pDrawList->vao));
+		GL_ASSERT(glDeleteBuffers(1, &pDrawList->vbo));
+	}
+
+	free(pDrawList->pDrawCalls);
+	memset(pDrawList, 0, sizeof(RendererDrawList));
+}
+
+static void bindShaderProgram(ShaderProgram* pShader)
+{
+	if (gDefaultRendererData.glState.program != pShader->program)
+	{
+		GL_ASSERT(glUseProgram(pShader->program));
+		gDefaultRendererData.glState.program = pShader->program;
+	}
+}
+
+static void bindVertexArray(u32 vertexArray)
+{
+	if (gDefaultRendererData.glState.vertexArray != vertexArray)
+	{
+		GL_ASSERT(glBindVertexArray(vertexArray));
+		gDefaultRendererData.glState.vertexArray = vertexArray;
+	}
+}
+
+/**
+ * Bind the framebuffer keeping the last frame for dirty region redraws, creating it or resizing it to the window.
+ * Resizing loses the retained pixels, the library redraws the whole frame after a resize anyway.
+ *
+ * @return `SI_FALSE` when the window has no area, the frame is then drawn directly to the window.
+ */
+static b8 bindRetainedFramebuffer()
+{
+	SiVector2 size = gDefaultRendererData.windowSize;
+	if (size.x < 1.0f || size.y < 1.0f)
+	{
+		return SI_FALSE;
+	}
+
+	if (gDefaultRendererData.retainedFramebuffer == 0u)
+	{
+		GL_ASSERT(glGenFramebuffers(1, &gDefaultRendererData.retainedFramebuffer));
+		GL_ASSERT(glGenRenderbuffers(1, &gDefaultRendererData.retainedColorBuffer));
+	}
+
+	GL_ASSERT(glBindFramebuffer(GL_FRAMEBUFFER, gDefaultRendererData.retainedFramebuffer));
+
+	if (gDefaultRendererData.retainedSize.x != size.x || gDefaultRendererData.retainedSize.y != size.y)
+	{
+		GL_ASSERT(glBindRenderbuffer(GL_RENDERBUFFER, gDefaultRendererData.retainedColorBuffer));
+		GL_ASSERT(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, (i32)size.x, (i32)size.y));
+		GL_ASSERT(glFramebufferRenderbuffer(
+			GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, gDefaultRendererData.retainedColorBuffer));
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			SI_ERROR_EXIT("Failed to create the retained framebuffer of %ux%u pixels.", (u32)size.x, (u32)size.y);
+		}
+
+		gDefaultRendererData.retainedSize = size;
+	}
 
-		DrawRectangleParameter rectParams = {};
-		rectParams.x					  = currentOffsetX + spriteSize.x / 2.0f;
-		rectParams.y					  = params.y + spriteSize.y / 2.0f;
-		rectParams.width				  = spriteSize.x;
-		rectParams.height				  = spriteSize.y;
-		rectParams.color				  = params.color;
-		rectParams.sprite				  = charSprite;
+	return SI_TRUE;
+}
 
-		siDrawRectangle_DefaultRenderer(rectParams, &gDefaultRendererData.textShader);
+static void bindArrayBuffer(u32 buffer)
+{
+	if (gDefaultRendererData.glState.arrayBuffer != buffer)
+	{
+		GL_ASSERT(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+		gDefaultRendererData.glState.arrayBuffer = buffer;
+	}
+}
 
-		currentOffsetX += spriteSize.x + xSpacing;
+static void bindTexture(u32 textureId)
+{
+	if (gDefaultRendererData.glState.texture != textureId)
+	{
+		GL_ASSERT(glBindTexture(GL_TEXTURE_2D, textureId));
+		gDefaultRendererData.glState.texture = textureId;
 	}
 }
 
-static void addVec2Uniform(DrawCall* pDrawCall, const char* name, SiVector2 vec)
+/**
+ * Grows `pArray` geometrically so that it can hold at least `requiredCount` elements. The capacity is only ever
+ * doubled, so appending to the array is amortized O(1) and stops allocating once the frame size is steady.
+ */
+static void* growArray(void* pArray, u32* pCapacity, u32 requiredCount, u32 elementSize)
 {
-	pDrawCall->uniformCount++;
-	Uniform* pUniform  = &pDrawCall->uniforms[pDrawCall->uniformCount - 1];
-	pUniform->type	   = UNIFORM_TYPE_VEC2;
-	pUniform->location = glGetUniformLocation(pDrawCall->shader, name);
+	if (requiredCount <= *pCapacity)
+	{
+		return pArray;
+	}
 
-	memcpy(pUniform->value.vec2Value, &vec, sizeof(pUniform->value.vec2Value));
+	u32 newCapacity = *pCapacity > 0u ? *pCapacity : 1u;
+	while (newCapacity < requiredCount)
+	{
+		newCapacity *= 2u;
+	}
 
-	if (pUniform->location == -1)
+	void* pNewArray = realloc(pArray, (size_t)newCapacity * elementSize);
+	if (pNewArray == NULL)
 	{
-		siPrintWarning("SIMUI: Failed to get uniform location for '%s'.", name);
-		pDrawCall->uniformCount--;
+		SI_ERROR_EXIT("Failed to grow renderer array to %u elements.", newCapacity);
 	}
+
+	*pCapacity = newCapacity;
+	return pNewArray;
 }
 
-static void addVec4Uniform(DrawCall* pDrawCall, const char* name, SiVector4 vec)
+/**
+ * Attaches `vertexBuffer` and the shared quad index buffer to the bound VAO and describes the layout of `RenderQuad`
+ * inside the buffer. Used for the frame's streamed buffer and for the static buffer of every draw list.
+ */
+static void setupVertexArray(u32 vertexBuffer)
 {
-	pDrawCall->uniformCount++;
-	Uniform* pUniform  = &pDrawCall->uniforms[pDrawCall->uniformCount - 1];
-	pUniform->type	   = UNIFORM_TYPE_VEC4;
-	pUniform->location = glGetUniformLocation(pDrawCall->shader, name);
+	bindArrayBuffer(vertexBuffer);
 
-	memcpy(pUniform->value.vec4Value, &vec, sizeof(pUniform->value.vec4Value));
+	// The element buffer binding is part of the VAO state, so it stays attached for every draw.
+	GL_ASSERT(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gDefaultRendererData.ebo));
 
-	if (pUniform->location == -1)
+#ifdef SIMUI_USE_INSTANCED_PIPELINE
+	for (u32 attributeIndex = 0u; attributeIndex < 4u; ++attributeIndex)
 	{
-		siPrintWarning("SIMUI: Failed to get uniform location for '%s'.", name);
-		pDrawCall->uniformCount--;
+		GL_ASSERT(glEnableVertexAttribArray(attributeIndex));
+		GL_ASSERT(glVertexAttribDivisor(attributeIndex, 1));
 	}
+	setInstanceAttributes(0u);
+#else
+	GL_ASSERT(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(RenderVertex), (void*)0));
+	GL_ASSERT(glEnableVertexAttribArray(0));
+	GL_ASSERT(glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(RenderVertex), (void*)(2 * sizeof(f32))));
+	GL_ASSERT(glEnableVertexAttribArray(1));
+	GL_ASSERT(glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(RenderVertex), (void*)(4 * sizeof(f32))));
+	GL_ASSERT(glEnableVertexAttribArray(2));
+#endif // SIMUI_USE_INSTANCED_PIPELINE
 }
 
-static void addSamplerUniform(DrawCall* pDrawCall, const char* name, u32 textureUnit, u32 texture)
+#ifdef SIMUI_USE_INSTANCED_PIPELINE
+/**
+ * Points the per-instance attributes at `firstInstance` inside the instance buffer. The VAO and the instance buffer
+ * must be bound.
+ */
+static void setInstanceAttributes(u32 firstInstance)
 {
-	TEXTURE_VALIDATE(texture);
-	SiTextureData* pTexture = &gTexturesHub[texture];
-	pDrawCall->uniformCount++;
-	Uniform* pUniform  = &pDrawCall->uniforms[pDrawCall->uniformCount - 1];
-	pUniform->type	   = UNIFORM_TYPE_SAMPLER2D;
-	pUniform->location = glGetUniformLocation(pDrawCall->shader, name);
+	uintptr_t base = (uintptr_t)firstInstance * sizeof(RenderQuad);
+
+	GL_ASSERT(glVertexAttribPointer(
+		0, 4, GL_FLOAT, GL_FALSE, sizeof(RenderQuad), (void*)(base + offsetof(RenderQuad, rect))));
+	GL_ASSERT(glVertexAttribPointer(
+		1, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(RenderQuad), (void*)(base + offsetof(RenderQuad, uvRect))));
+	GL_ASSERT(glVertexAttribPointer(
+		2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(RenderQuad), (void*)(base + offsetof(RenderQuad, color))));
+	GL_ASSERT(glVertexAttribPointer(
+		3, 2, GL_FLOAT, GL_FALSE, sizeof(RenderQuad), (void*)(base + offsetof(RenderQuad, style))));
+}
+#endif // SIMUI_USE_INSTANCED_PIPELINE
 
-	if (pUniform->location == -1)
+/**
+ * Makes sure that the static index pattern `0, 1, 2, 2, 3, 0` (offset by 4 per quad) inside the element buffer covers
+ * at least `quadCount` quads. The pattern is only rebuilt when the frame outgrows it. The VAO must be bound.
+ */
+static void ensureQuadIndices(u32 quadCount)
+{
+	if (quadCount <= gDefaultRendererData.quadIndexCapacity)
 	{
-		siPrintWarning("SIMUI: Failed to get uniform location for '%s'.", name);
-		pDrawCall->uniformCount--;
+		return;
 	}
 
-	pUniform->value.sampler2DValue.textureUnit = textureUnit; // Texture unit 0
-	pUniform->value.sampler2DValue.textureId   = pTexture->textureId;
+	u32 newCapacity = gDefaultRendererData.quadIndexCapacity;
+	u32* pIndices	= (u32*)growArray(NULL, &newCapacity, quadCount, sizeof(u32) * INDICES_PER_QUAD);
+
+	for (u32 quadIndex = 0u; quadIndex < newCapacity; ++quadIndex)
+	{
+		u32	 firstVertex = quadIndex * VERTICES_PER_QUAD;
+		u32* pQuad		 = &pIndices[quadIndex * INDICES_PER_QUAD];
+		pQuad[0]		 = firstVertex + 0;
+		pQuad[1]		 = firstVertex + 1;
+		pQuad[2]		 = firstVertex + 2;
+		pQuad[3]		 = firstVertex + 2;
+		pQuad[4]		 = firstVertex + 3;
+		pQuad[5]		 = firstVertex + 0;
+	}
+
+	GL_ASSERT(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gDefaultRendererData.ebo));
+	GL_ASSERT(glBufferData(
+		GL_ELEMENT_ARRAY_BUFFER, sizeof(u32) * INDICES_PER_QUAD * newCapacity, pIndices, GL_STATIC_DRAW));
+	free(pIndices);
+
+	gDefaultRendererData.quadIndexCapacity = newCapacity;
 }
 
 static SiVector2 siGetWindowSize_DefaultRenderer(void* pRenderingData)
@@ -568,25 +1294,13 @@ static SiVector2 siGetWindowSize_DefaultRenderer(void* pRenderingData)
 
 SiTexture siCreateTexture(u32 width, u32 height, SiTextureFormat format, const void* pData)
 {
-	// Find an unused texture slot
-	u32 textureIndex = 0;
-	for (textureIndex = 0; textureIndex < MAX_TEXTURES; ++textureIndex)
-	{
-		if (!gTexturesHub[textureIndex].isUsed)
-		{
-			break;
-		}
-	}
-
-	SiTextureData* pTexture = &gTexturesHub[textureIndex];
-	memset(pTexture, 0, sizeof(SiTextureData));
+	// The slots are shared with the render thread, which creates the glyph atlas pages.
+	siAcquireRenderContext();
 
-	pTexture->width	 = width;
-	pTexture->height = height;
-	pTexture->format = format;
-	pTexture->isUsed = SI_TRUE;
-	GL_ASSERT(glGenTextures(1, &pTexture->textureId));
-	GL_ASSERT(glBindTexture(GL_TEXTURE_2D, pTexture->textureId));
+	SiTexture texture	 = siAllocateTextureSlot(width, height, format);
+	u32*	  pTextureId = getTextureId(texture);
+	GL_ASSERT(glGenTextures(1, pTextureId));
+	bindTexture(*pTextureId);
 	GL_ASSERT(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
 	GL_ASSERT(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
 	GL_ASSERT(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
@@ -607,46 +1321,170 @@ SiTexture siCreateTexture(u32 width, u32 height, SiTextureFormat format, const v
 		SI_ERROR_EXIT("Unsupported texture format.");
 		break;
 	}
+	siReleaseRenderContext();
 
-	return (u32)textureIndex;
+	return texture;
 }
 
-SiVector2 siGetTextureSize(SiTexture texture)
+static GLenum getPixelFormat(SiTextureFormat format)
 {
-	TEXTURE_VALIDATE(texture);
-	SiTextureData* pTexture = &gTexturesHub[texture];
-	SiVector2	   size		= {(f32)pTexture->width, (f32)pTexture->height};
-	return size;
+	switch (format)
+	{
+	case SI_TEXTURE_FORMAT_RGBA8:
+		return GL_RGBA;
+	case SI_TEXTURE_FORMAT_RGB8:
+		return GL_RGB;
+	case SI_TEXTURE_FORMAT_R8:
+		return GL_ALPHA;
+	default:
+		SI_ERROR_EXIT("Unsupported texture format.");
+		return GL_RGBA;
+	}
 }
 
-SiVector2 siGetSpriteSize(SiSprite sprite)
+static u32 getBytesPerPixel(SiTextureFormat format)
 {
-	TEXTURE_VALIDATE(sprite.texture);
-	SiTextureData* pTexture	   = &gTexturesHub[sprite.texture];
-	SiVector2	   textureSize = {(f32)pTexture->width, (f32)pTexture->height};
+	switch (format)
+	{
+	case SI_TEXTURE_FORMAT_RGBA8:
+		return 4u;
+	case SI_TEXTURE_FORMAT_RGB8:
+		return 3u;
+	default:
+		return 1u;
+	}
+}
 
-	SiVector2 size;
-	size.x = (sprite.quadMax.x - sprite.quadMin.x) * textureSize.x;
-	size.y = (sprite.quadMax.y - sprite.quadMin.y) * textureSize.y;
+/**
+ * Bind the next buffer of the upload ring to `GL_PIXEL_UNPACK_BUFFER` and map `size` bytes of it for writing. The
+ * whole buffer is invalidated, so while the GPU may still read the previous upload from it the driver hands out fresh
+ * storage instead of waiting; once its fence is signaled the storage is reused without any synchronization.
+ */
+static void* mapUploadBuffer(u64 size)
+{
+	UploadBuffer* pUploadBuffer			  = &gDefaultRendererData.uploadBuffers[gDefaultRendererData.nextUploadBuffer];
+	gDefaultRendererData.nextUploadBuffer = (gDefaultRendererData.nextUploadBuffer + 1u) % UPLOAD_BUFFER_COUNT;
 
-	return size;
+	if (pUploadBuffer->buffer == 0u)
+	{
+		GL_ASSERT(glGenBuffers(1, &pUploadBuffer->buffer));
+	}
+	GL_ASSERT(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pUploadBuffer->buffer));
+
+	GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+	if (size > pUploadBuffer->capacity)
+	{
+		GL_ASSERT(glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size, NULL, GL_STREAM_DRAW));
+		pUploadBuffer->capacity = size;
+	}
+	else if (pUploadBuffer->fence != NULL)
+	{
+		GLenum status = glClientWaitSync(pUploadBuffer->fence, 0, 0);
+		if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+		{
+			access |= GL_MAP_UNSYNCHRONIZED_BIT;
+		}
+	}
+
+	if (pUploadBuffer->fence != NULL)
+	{
+		GL_ASSERT(glDeleteSync(pUploadBuffer->fence));
+		pUploadBuffer->fence = NULL;
+	}
+
+	void* pMapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size, access);
+	if (pMapped == NULL)
+	{
+		SI_ERROR_EXIT("Failed to map a texture upload buffer of %llu bytes.", (unsigned long long)size);
+	}
+
+	return pMapped;
+}
+
+/**
+ * Unmap the upload buffer bound by `mapUploadBuffer` and copy it into a region of `texture` on the GPU timeline.
+ */
+static void submitUploadBuffer(SiTexture texture, u32 x, u32 y, u32 width, u32 height)
+{
+	SiTextureSlot* pSlot		 = siGetTextureSlot(texture);
+	u32			   bufferIndex	 = gDefaultRendererData.nextUploadBuffer + UPLOAD_BUFFER_COUNT - 1u;
+	UploadBuffer*  pUploadBuffer = &gDefaultRendererData.uploadBuffers[bufferIndex % UPLOAD_BUFFER_COUNT];
+
+	GL_ASSERT(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+	bindTexture(*getTextureId(texture));
+	GL_ASSERT(glTexSubImage2D(
+		GL_TEXTURE_2D, 0, x, y, width, height, getPixelFormat(pSlot->format), GL_UNSIGNED_BYTE, (const void*)0));
+
+	// Left bound, the buffer would turn the client pointers of later texture calls into offsets.
+	GL_ASSERT(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+	pUploadBuffer->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 }
 
-SiTextureFormat siGetTextureFormat(SiTexture texture)
+void siUpdateTexture(SiTexture texture, u32 x, u32 y, u32 width, u32 height, const void* pData)
 {
-	TEXTURE_VALIDATE(texture);
+	siValidateTexture(texture);
+	SiTextureSlot* pSlot = siGetTextureSlot(texture);
+
+	siAcquireRenderContext();
+	u64 size = (u64)width * height * getBytesPerPixel(pSlot->format);
+	memcpy(mapUploadBuffer(size), pData, size);
+	submitUploadBuffer(texture, x, y, width, height);
+	siReleaseRenderContext();
+}
+
+void* siMapTextureRegion(SiTexture texture, u32 x, u32 y, u32 width, u32 height)
+{
+	siValidateTexture(texture);
+	SiTextureSlot* pSlot = siGetTextureSlot(texture);
+
+	if (gDefaultRendererData.mappedTexture != SI_TEXTURE_NULL)
+	{
+		SI_ERROR_EXIT("siMapTextureRegion called while another region is mapped, siUnmapTextureRegion is missing.");
+	}
+
+	// The context stays with the calling thread until the region is unmapped.
+	siAcquireRenderContext();
+	gDefaultRendererData.mappedTexture	 = texture;
+	gDefaultRendererData.mappedRegion[0] = x;
+	gDefaultRendererData.mappedRegion[1] = y;
+	gDefaultRendererData.mappedRegion[2] = width;
+	gDefaultRendererData.mappedRegion[3] = height;
 
-	SiTextureData* pTexture = &gTexturesHub[texture];
-	return pTexture->format;
+	return mapUploadBuffer((u64)width * height * getBytesPerPixel(pSlot->format));
+}
+
+void siUnmapTextureRegion(SiTexture texture)
+{
+	siValidateTexture(texture);
+
+	if (gDefaultRendererData.mappedTexture != texture)
+	{
+		SI_ERROR_EXIT("siUnmapTextureRegion called without siMapTextureRegion.");
+	}
+
+	u32* pRegion = gDefaultRendererData.mappedRegion;
+	submitUploadBuffer(texture, pRegion[0], pRegion[1], pRegion[2], pRegion[3]);
+	gDefaultRendererData.mappedTexture = SI_TEXTURE_NULL;
+	siReleaseRenderContext();
 }
 
 void siDestroyTexture(SiTexture texture)
 {
-	TEXTURE_VALIDATE(texture);
+	siValidateTexture(texture);
+
+	siAcquireRenderContext();
+
+	u32* pTextureId = getTextureId(texture);
+	if (gDefaultRendererData.glState.texture == *pTextureId)
+	{
+		gDefaultRendererData.glState.texture = 0u;
+	}
+
+	GL_ASSERT(glDeleteTextures(1, pTextureId));
+	siReleaseTextureSlot(texture);
 
-	SiTextureData* pTexture = &gTexturesHub[texture];
-	GL_ASSERT(glDeleteTextures(1, &pTexture->textureId));
-	pTexture->isUsed = SI_FALSE;
+	siReleaseRenderContext();
 }
 
 #endif // SIMUI_USE_DEFAULT_RENDERER
@@ -0,0 +1,1135 @@
+#if SIMUI_USE_SOFTWARE_RENDERER
+#include "simui/simui.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define SOFTWARE_USE_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef SIMUI_USE_STB
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+#endif // SIMUI_USE_STB
+
+#define INITIAL_COMMAND_CAPACITY 1024
+#define BAND_HEIGHT				 32u  ///< Rows of the framebuffer claimed at once by a rasterizing thread.
+#define SPAN_PIXELS				 256u ///< Pixels shaded into the stack buffer before they are blended.
+#define CLEAR_VALUE				 26u  ///< The 0.1 grey the default renderer clears to, per color channel.
+
+#define SPAN_TEXELS (SPAN_PIXELS + 1u) ///< Texels sampled per span, the SDF shader reads one past the last pixel.
+
+/**
+ * The fragment shader of the default renderer a command is rasterized like.
+ */
+typedef enum SoftwareShader
+{
+	SOFTWARE_SHADER_COLOR,	  ///< Flat color, with the rounded corners and border of `rounded.frag`.
+	SOFTWARE_SHADER_TEXTURE,  ///< `texture.frag`, the texel multiplied by the color.
+	SOFTWARE_SHADER_TEXT,	  ///< `text.frag`, the alpha of the texel multiplied by the color.
+	SOFTWARE_SHADER_TEXT_SDF, ///< `text_sdf.frag`, the alpha of the texel read as a distance field.
+} SoftwareShader;
+
+typedef struct SoftwareCommand
+{
+	DrawRectangleParameter params;	 ///< The rectangle, or the offset of the replay in `x` and `y`.
+	SoftwareShader		   shader;	 ///< How the pixels of the rectangle are shaded.
+	SiDrawList			   drawList; ///< The draw list replayed by the command, or `SI_DRAW_LIST_NULL`.
+} SoftwareCommand;
+
+typedef struct SoftwareCommandList
+{
+	SoftwareCommand* pCommands;
+	u32				 count;
+	u32				 capacity;
+} SoftwareCommandList;
+
+/**
+ * Everything the rasterizing threads share. The commands and the framebuffer are only written outside of
+ * `siEndFrame_SoftwareRenderer`, while rasterizing every thread only writes the rows of the bands it claimed.
+ */
+typedef struct SoftwareRendererData
+{
+	u32* pFramebuffer; ///< RGBA8 pixels, top row first.
+	u32	 width;
+	u32	 height;
+
+	SoftwareCommandList	 frame;						  ///< The commands of the frame being recorded.
+	SoftwareCommandList	 drawLists[SI_MAX_DRAW_LISTS]; ///< The commands captured by every draw list.
+	SoftwareCommandList* pRecording;				  ///< `frame`, or the draw list being recorded.
+	b8					 hasDirtyRegion;			  ///< Set by `siSetDirtyRegion_SoftwareRenderer` for one frame.
+	SiVector4			 dirtyRegion;				  ///< The region of the frame to redraw, in drawing coordinates.
+	i32					 clip[4];					  ///< Left, top, right and bottom pixels drawn this frame.
+
+	SiThread* pWorkers[SI_SOFTWARE_RENDERER_THREADS]; ///< The threads helping the one calling `siRender`.
+
+	SiMutex*	 pMutex;			///< Guards the band counters and the fields below.
+	SiCondition* pCondition;		///< Broadcast when a frame is started, finished or the workers must stop.
+	u32			 frameSerial;		///< Bumped for every rasterized frame, so the workers notice new frames.
+	u32			 bandCount;			///< The number of bands of the frame being rasterized.
+	u32			 nextBand;			///< The next band no thread claimed yet.
+	u32			 finishedBandCount; ///< The number of bands rasterized so far.
+	b8			 shouldStop;		///< Set on shutdown, the workers return.
+
+	SiTexture mappedTexture;   ///< The texture mapped by `siMapTextureRegion`, or `SI_TEXTURE_NULL`.
+	u32		  mappedRegion[4]; ///< The x, y, width and height of the mapped region.
+	u8*		  pMappedPixels;   ///< The staging copy handed out by `siMapTextureRegion`.
+} SoftwareRendererData;
+
+static SoftwareRendererData gSoftwareRendererData;
+
+/**
+ * The texels of `texture` in its format, tightly packed with the top row first. The software renderer keeps the pointer
+ * in the texture pool next to every slot.
+ */
+static u8** getTexturePixels(SiTexture texture)
+{
+	return (u8**)siGetTextureSlotData(texture);
+}
+
+static void		 siInitialize_SoftwareRenderer();
+static void		 siPollEvents_SoftwareRenderer();
+static void		 siBeginFrame_SoftwareRenderer();
+static void		 siEndFrame_SoftwareRenderer();
+static void		 siSkipFrame_SoftwareRenderer();
+static void		 siSetDirtyRegion_SoftwareRenderer(SiVector4 region);
+static void		 siMakeContextCurrent_SoftwareRenderer(b8 isCurrent);
+static void		 siShutdown_SoftwareRenderer();
+static void		 siDrawRectangle_SoftwareRenderer(DrawRectangleParameter params, void* pRenderingData);
+static void		 siDrawText_SoftwareRenderer(DrawTextParameter params, void* pRenderingData);
+static SiVector2 siGetWindowSize_SoftwareRenderer(void* pRenderingData);
+
+static void siDrawList_SoftwareRenderer(DrawListParameter params, void* pRenderingData);
+static void siBeginDrawList_SoftwareRenderer(SiDrawList drawList);
+static void siEndDrawList_SoftwareRenderer(SiDrawList drawList);
+static void siDestroyDrawList_SoftwareRenderer(SiDrawList drawList);
+
+void siConfigureCallbacks()
+{
+	SiCallbackHub* hub = &gSiCallbackHub;
+
+	hub->initializeFunction	   = siInitialize_SoftwareRenderer;
+	hub->pollEventsFunction	   = siPollEvents_SoftwareRenderer;
+	hub->beginFrameFunction	   = siBeginFrame_SoftwareRenderer;
+	hub->endFrameFunction	   = siEndFrame_SoftwareRenderer;
+	hub->skipFrameFunction	   = siSkipFrame_SoftwareRenderer;
+	hub->shutdownFunction	   = siShutdown_SoftwareRenderer;
+	hub->getWindowSizeFunction = siGetWindowSize_SoftwareRenderer;
+
+	hub->setDirtyRegionFunction		= siSetDirtyRegion_SoftwareRenderer;
+	hub->makeContextCurrentFunction = siMakeContextCurrent_SoftwareRenderer;
+
+	hub->drawRectangleFunction = siDrawRectangle_SoftwareRenderer;
+	hub->drawTextFunction	   = siDrawText_SoftwareRenderer;
+
+	hub->drawListFunction		 = siDrawList_SoftwareRenderer;
+	hub->beginDrawListFunction	 = siBeginDrawList_SoftwareRenderer;
+	hub->endDrawListFunction	 = siEndDrawList_SoftwareRenderer;
+	hub->destroyDrawListFunction = siDestroyDrawList_SoftwareRenderer;
+}
+
+static SoftwareCommand* pushCommand(SoftwareCommandList* pList);
+static void				clearFramebuffer(u32* pPixels, u64 pixelCount);
+static void				runRasterWorker(void* pArgument);
+static void				rasterizeBands();
+static void				rasterizeBand(u32 band);
+static void rasterizeCommands(const SoftwareCommandList* pList, SiVector2 offset, const i32 pClip[4], u32 depth);
+static void rasterizeRectangle(const SoftwareCommand* pCommand, SiVector2 offset, const i32 pClip[4]);
+
+static u32	packPixel(u32 r, u32 g, u32 b, u32 a);
+static void blendSpan(u32* pDestination, const u32* pSource, u32 count);
+static u32	getBytesPerPixel(SiTextureFormat format);
+
+static void siInitialize_SoftwareRenderer()
+{
+	memset(&gSoftwareRendererData, 0, sizeof(gSoftwareRendererData));
+	gSoftwareRendererData.mappedTexture = SI_TEXTURE_NULL;
+	gSoftwareRendererData.pRecording	= &gSoftwareRendererData.frame;
+	siInitializeTexturePool(sizeof(u8*));
+
+	siResizeSoftwareFramebuffer(SI_SOFTWARE_FRAMEBUFFER_WIDTH, SI_SOFTWARE_FRAMEBUFFER_HEIGHT);
+
+	gSoftwareRendererData.pMutex	 = siCreateMutex();
+	gSoftwareRendererData.pCondition = siCreateCondition();
+
+	// The thread calling `siRender` rasterizes bands as well, so one worker less is started.
+	for (u32 workerIndex = 0u; workerIndex + 1u < SI_SOFTWARE_RENDERER_THREADS; ++workerIndex)
+	{
+		gSoftwareRendererData.pWorkers[workerIndex] = siCreateThread(runRasterWorker, SI_NULL);
+	}
+
+	gSiContext.pRenderingData = &gSoftwareRendererData;
+}
+
+static void siPollEvents_SoftwareRenderer()
+{
+	// There is no window, hence no input and nothing asking the application to close.
+}
+
+static void siSetDirtyRegion_SoftwareRenderer(SiVector4 region)
+{
+	gSoftwareRendererData.hasDirtyRegion = SI_TRUE;
+	gSoftwareRendererData.dirtyRegion	 = region;
+}
+
+static void siMakeContextCurrent_SoftwareRenderer(b8 isCurrent)
+{
+	// The framebuffer is plain memory, any thread holding the render context may draw into it.
+}
+
+static void siBeginFrame_SoftwareRenderer()
+{
+	i32* pClip	= gSoftwareRendererData.clip;
+	i32	 width	= (i32)gSoftwareRendererData.width;
+	i32	 height = (i32)gSoftwareRendererData.height;
+
+	pClip[0] = 0;
+	pClip[1] = 0;
+	pClip[2] = width;
+	pClip[3] = height;
+
+	if (gSoftwareRendererData.hasDirtyRegion)
+	{
+		// Drawing coordinates span twice the framebuffer size with y pointing up, while the rows of the framebuffer
+		// go down. The clip is rounded outwards to whole pixels, the pixels outside of it keep the last frame.
+		SiVector4 region = gSoftwareRendererData.dirtyRegion;
+		f32		  left	 = floorf(region.x / 2.0f);
+		f32		  bottom = floorf(region.y / 2.0f);
+		f32		  right	 = ceilf(region.z / 2.0f);
+		f32		  top	 = ceilf(region.w / 2.0f);
+
+		pClip[0] = left > 0.0f ? (left < (f32)width ? (i32)left : width) : 0;
+		pClip[2] = right < (f32)width ? (right > 0.0f ? (i32)right : 0) : width;
+		pClip[1] = top < (f32)height ? (top > 0.0f ? height - (i32)top : height) : 0;
+		pClip[3] = bottom > 0.0f ? (bottom < (f32)height ? height - (i32)bottom : 0) : height;
+	}
+}
+
+static void siEndFrame_SoftwareRenderer()
+{
+	SoftwareRendererData* pData = &gSoftwareRendererData;
+
+	siLockMutex(pData->pMutex);
+	pData->bandCount		 = (pData->height + BAND_HEIGHT - 1u) / BAND_HEIGHT;
+	pData->nextBand			 = 0u;
+	pData->finishedBandCount = 0u;
+	pData->frameSerial++;
+	siBroadcastCondition(pData->pCondition);
+	siUnlockMutex(pData->pMutex);
+
+	rasterizeBands();
+
+	siLockMutex(pData->pMutex);
+	while (pData->finishedBandCount < pData->bandCount)
+	{
+		siWaitCondition(pData->pCondition, pData->pMutex);
+	}
+	siUnlockMutex(pData->pMutex);
+
+	// Reset for next frame
+	{
+		pData->frame.count	  = 0u;
+		pData->hasDirtyRegion = SI_FALSE;
+	}
+}
+
+static void siSkipFrame_SoftwareRenderer()
+{
+	// The framebuffer already holds the unchanged frame, and without a display there is no interval to wait for.
+}
+
+static void siShutdown_SoftwareRenderer()
+{
+	SoftwareRendererData* pData = &gSoftwareRendererData;
+
+	siLockMutex(pData->pMutex);
+	pData->shouldStop = SI_TRUE;
+	siBroadcastCondition(pData->pCondition);
+	siUnlockMutex(pData->pMutex);
+
+	for (u32 workerIndex = 0u; workerIndex + 1u < SI_SOFTWARE_RENDERER_THREADS; ++workerIndex)
+	{
+		siJoinThread(pData->pWorkers[workerIndex]);
+	}
+	siDestroyCondition(pData->pCondition);
+	siDestroyMutex(pData->pMutex);
+
+	siShutdownTexturePool();
+
+	for (u32 drawListIndex = 0u; drawListIndex < SI_MAX_DRAW_LISTS; ++drawListIndex)
+	{
+		free(pData->drawLists[drawListIndex].pCommands);
+	}
+	free(pData->frame.pCommands);
+	free(pData->pMappedPixels);
+	free(pData->pFramebuffer);
+	memset(pData, 0, sizeof(SoftwareRendererData));
+}
+
+static void siDrawRectangle_SoftwareRenderer(DrawRectangleParameter params, void* pRenderingData)
+{
+	if (params.sprite.texture != SI_TEXTURE_NULL)
+	{
+		siValidateTexture(params.sprite.texture);
+	}
+
+	SoftwareCommand* pCommand = pushCommand(gSoftwareRendererData.pRecording);
+	pCommand->params		  = params;
+	pCommand->shader = params.sprite.texture != SI_TEXTURE_NULL ? SOFTWARE_SHADER_TEXTURE : SOFTWARE_SHADER_COLOR;
+}
+
+/**
+ * A text being drawn by `siDrawText_SoftwareRenderer`, handed to `pushGlyphCommand` for each of its glyphs.
+ */
+typedef struct GlyphCommands
+{
+	SoftwareShader		   shader; ///< `SOFTWARE_SHADER_TEXT` or `SOFTWARE_SHADER_TEXT_SDF`, like the font.
+	DrawRectangleParameter params; ///< The color of the text, the rectangle and sprite are set per glyph.
+} GlyphCommands;
+
+static void pushGlyphCommand(const SiGlyph* pGlyph, SiVector2 center, void* pUserData)
+{
+	GlyphCommands* pCommands		 = (GlyphCommands*)pUserData;
+	pCommands->params.x				 = center.x;
+	pCommands->params.y				 = center.y;
+	pCommands->params.width			 = pGlyph->size.x;
+	pCommands->params.height		 = pGlyph->size.y;
+	pCommands->params.sprite.texture = pGlyph->texture;
+	pCommands->params.sprite.quadMin = pGlyph->quadMin;
+	pCommands->params.sprite.quadMax = pGlyph->quadMax;
+
+	SoftwareCommand* pCommand = pushCommand(gSoftwareRendererData.pRecording);
+	pCommand->params		  = pCommands->params;
+	pCommand->shader		  = pCommands->shader;
+}
+
+static void siDrawText_SoftwareRenderer(DrawTextParameter params, void* pRenderingData)
+{
+	SiFont* pFont = params.pFont;
+
+	SoftwareShader shader =
+		pFont->rasterization == SI_FONT_RASTERIZATION_SDF ? SOFTWARE_SHADER_TEXT_SDF : SOFTWARE_SHADER_TEXT;
+
+	GlyphCommands commands = {0};
+	commands.shader		   = shader;
+	commands.params.color  = params.color;
+
+	siLayoutText(pFont, params.x, params.y, params.text, pushGlyphCommand, &commands);
+}
+
+static void siDrawList_SoftwareRenderer(DrawListParameter params, void* pRenderingData)
+{
+	if (gSoftwareRendererData.drawLists[params.drawList].count == 0u)
+	{
+		return;
+	}
+
+	SoftwareCommand* pCommand = pushCommand(gSoftwareRendererData.pRecording);
+	pCommand->params.x		  = params.offsetX;
+	pCommand->params.y		  = params.offsetY;
+	pCommand->drawList		  = params.drawList;
+}
+
+static void siBeginDrawList_SoftwareRenderer(SiDrawList drawList)
+{
+	// The commands are copied as they are, a replay only moves them, so the list records straight into its own array.
+	gSoftwareRendererData.drawLists[drawList].count = 0u;
+	gSoftwareRendererData.pRecording				= &gSoftwareRendererData.drawLists[drawList];
+}
+
+static void siEndDrawList_SoftwareRenderer(SiDrawList drawList)
+{
+	gSoftwareRendererData.pRecording = &gSoftwareRendererData.frame;
+}
+
+static void siDestroyDrawList_SoftwareRenderer(SiDrawList drawList)
+{
+	SoftwareCommandList* pDrawList = &gSoftwareRendererData.drawLists[drawList];
+	free(pDrawList->pCommands);
+	memset(pDrawList, 0, sizeof(SoftwareCommandList));
+}
+
+static SiVector2 siGetWindowSize_SoftwareRenderer(void* pRenderingData)
+{
+	SoftwareRendererData* pData = (SoftwareRendererData*)pRenderingData;
+	SiVector2			  size	= {(f32)pData->width, (f32)pData->height};
+	return size;
+}
+
+/**
+ * Append a zeroed command to `pList`, doubling its capacity when it is full.
+ */
+static SoftwareCommand* pushCommand(SoftwareCommandList* pList)
+{
+	if (pList->count == pList->capacity)
+	{
+		u32 newCapacity = pList->capacity == 0u ? INITIAL_COMMAND_CAPACITY : pList->capacity * 2u;
+
+		SoftwareCommand* pCommands =
+			(SoftwareCommand*)realloc(pList->pCommands, sizeof(SoftwareCommand) * newCapacity);
+		if (pCommands == SI_NULL)
+		{
+			SI_ERROR_EXIT("Failed to grow a software command list to %u commands.", newCapacity);
+		}
+
+		pList->pCommands = pCommands;
+		pList->capacity	 = newCapacity;
+	}
+
+	SoftwareCommand* pCommand = &pList->pCommands[pList->count++];
+	memset(pCommand, 0, sizeof(SoftwareCommand));
+	pCommand->drawList = SI_DRAW_LIST_NULL;
+	return pCommand;
+}
+
+static void clearFramebuffer(u32* pPixels, u64 pixelCount)
+{
+	u32 clearPixel = packPixel(CLEAR_VALUE, CLEAR_VALUE, CLEAR_VALUE, 255u);
+	for (u64 pixelIndex = 0u; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		pPixels[pixelIndex] = clearPixel;
+	}
+}
+
+// =========================== Rasterization ===========================
+/**
+ * Main loop of the worker threads: wait for `siEndFrame_SoftwareRenderer` to start a frame, help rasterizing it, and
+ * wait for the next one.
+ */
+static void runRasterWorker(void* pArgument)
+{
+	SoftwareRendererData* pData		  = &gSoftwareRendererData;
+	u32					  frameSerial = 0u;
+
+	siLockMutex(pData->pMutex);
+	while (!pData->shouldStop)
+	{
+		if (pData->frameSerial == frameSerial)
+		{
+			siWaitCondition(pData->pCondition, pData->pMutex);
+			continue;
+		}
+
+		frameSerial = pData->frameSerial;
+		siUnlockMutex(pData->pMutex);
+		rasterizeBands();
+		siLockMutex(pData->pMutex);
+	}
+	siUnlockMutex(pData->pMutex);
+}
+
+/**
+ * Claim and rasterize bands of the current frame until none is left. Bands are claimed one at a time, so threads
+ * finishing early take over the bands of slower ones.
+ */
+static void rasterizeBands()
+{
+	SoftwareRendererData* pData = &gSoftwareRendererData;
+
+	siLockMutex(pData->pMutex);
+	while (pData->nextBand < pData->bandCount)
+	{
+		u32 band = pData->nextBand++;
+		siUnlockMutex(pData->pMutex);
+
+		rasterizeBand(band);
+
+		siLockMutex(pData->pMutex);
+		if (++pData->finishedBandCount == pData->bandCount)
+		{
+			siBroadcastCondition(pData->pCondition);
+		}
+	}
+	siUnlockMutex(pData->pMutex);
+}
+
+/**
+ * Clear the rows of `band` inside the clip of the frame and draw every command of the frame over them, in order.
+ */
+static void rasterizeBand(u32 band)
+{
+	SoftwareRendererData* pData = &gSoftwareRendererData;
+
+	i32 clip[4] = {pData->clip[0], pData->clip[1], pData->clip[2], pData->clip[3]};
+	i32 top		= (i32)(band * BAND_HEIGHT);
+	i32 bottom	= top + (i32)BAND_HEIGHT;
+
+	clip[1] = clip[1] > top ? clip[1] : top;
+	clip[3] = clip[3] < bottom ? clip[3] : bottom;
+	if (clip[0] >= clip[2] || clip[1] >= clip[3])
+	{
+		return;
+	}
+
+	for (i32 row = clip[1]; row < clip[3]; ++row)
+	{
+		clearFramebuffer(&pData->pFramebuffer[(u64)row * pData->width + (u32)clip[0]], (u64)(clip[2] - clip[0]));
+	}
+
+	rasterizeCommands(&pData->frame, (SiVector2){0.0f, 0.0f}, clip, 0u);
+}
+
+static void rasterizeCommands(const SoftwareCommandList* pList, SiVector2 offset, const i32 pClip[4], u32 depth)
+{
+	for (u32 commandIndex = 0u; commandIndex < pList->count; ++commandIndex)
+	{
+		const SoftwareCommand* pCommand = &pList->pCommands[commandIndex];
+
+		if (pCommand->drawList == SI_DRAW_LIST_NULL)
+		{
+			rasterizeRectangle(pCommand, offset, pClip);
+		}
+		else if (depth < SI_MAX_DRAW_LISTS)
+		{
+			// Nested replays add up their offsets, the depth check stops a list replaying itself.
+			SiVector2 listOffset = {offset.x + pCommand->params.x, offset.y + pCommand->params.y};
+			rasterizeCommands(&gSoftwareRendererData.drawLists[pCommand->drawList], listOffset, pClip, depth + 1u);
+		}
+	}
+}
+
+static i32 wrapCoordinate(i32 coordinate, u32 size)
+{
+	i32 wrapped = coordinate % (i32)size;
+	return wrapped < 0 ? wrapped + (i32)size : wrapped;
+}
+
+/**
+ * Filter the 4 texels gathered around each of `count` samples with 8-bit weights, the precision of the texture units
+ * of GPUs: horizontally with `pWeightsX` first, rounded to 8 bits, then vertically with `weightY`. The weights are the
+ * share of the right and of the bottom texels, out of 256. The results keep 8 fractional bits, a channel of 255 reads
+ * 65280. The SSE2 and NEON paths filter 8 samples at a time and round the same way as the scalar one.
+ */
+static void filterTexels(const u16 pCorners[4][SPAN_TEXELS], const u16* pWeightsX, u16 weightY, u32 count, u16* pResult)
+{
+	u32 sampleIndex = 0u;
+
+#if defined(SOFTWARE_USE_SSE2)
+	const __m128i full		  = _mm_set1_epi16(256);
+	const __m128i half		  = _mm_set1_epi16(128);
+	const __m128i lowerWeight = _mm_set1_epi16((i16)weightY);
+	const __m128i upperWeight = _mm_sub_epi16(full, lowerWeight);
+	for (; sampleIndex + 8u <= count; sampleIndex += 8u)
+	{
+		__m128i topLeft		= _mm_loadu_si128((const __m128i*)&pCorners[0][sampleIndex]);
+		__m128i topRight	= _mm_loadu_si128((const __m128i*)&pCorners[1][sampleIndex]);
+		__m128i bottomLeft	= _mm_loadu_si128((const __m128i*)&pCorners[2][sampleIndex]);
+		__m128i bottomRight = _mm_loadu_si128((const __m128i*)&pCorners[3][sampleIndex]);
+		__m128i right		= _mm_loadu_si128((const __m128i*)&pWeightsX[sampleIndex]);
+		__m128i left		= _mm_sub_epi16(full, right);
+
+		// Every product fits 16 bits: a channel of at most 255 times a weight of at most 256.
+		__m128i upper = _mm_add_epi16(_mm_mullo_epi16(topLeft, left), _mm_mullo_epi16(topRight, right));
+		__m128i lower = _mm_add_epi16(_mm_mullo_epi16(bottomLeft, left), _mm_mullo_epi16(bottomRight, right));
+		upper		  = _mm_srli_epi16(_mm_add_epi16(upper, half), 8);
+		lower		  = _mm_srli_epi16(_mm_add_epi16(lower, half), 8);
+
+		__m128i value = _mm_add_epi16(_mm_mullo_epi16(upper, upperWeight), _mm_mullo_epi16(lower, lowerWeight));
+		_mm_storeu_si128((__m128i*)&pResult[sampleIndex], value);
+	}
+#elif defined(SOFTWARE_USE_NEON)
+	const uint16x8_t full		 = vdupq_n_u16(256);
+	const uint16x8_t lowerWeight = vdupq_n_u16(weightY);
+	const uint16x8_t upperWeight = vsubq_u16(full, lowerWeight);
+	for (; sampleIndex + 8u <= count; sampleIndex += 8u)
+	{
+		uint16x8_t right = vld1q_u16(&pWeightsX[sampleIndex]);
+		uint16x8_t left	 = vsubq_u16(full, right);
+		uint16x8_t upper = vmlaq_u16(vmulq_u16(vld1q_u16(&pCorners[0][sampleIndex]), left),
+									 vld1q_u16(&pCorners[1][sampleIndex]),
+									 right);
+		uint16x8_t lower = vmlaq_u16(vmulq_u16(vld1q_u16(&pCorners[2][sampleIndex]), left),
+									 vld1q_u16(&pCorners[3][sampleIndex]),
+									 right);
+
+		// The rounding shift adds 128 before shifting, like the other paths.
+		upper = vrshrq_n_u16(upper, 8);
+		lower = vrshrq_n_u16(lower, 8);
+		vst1q_u16(&pResult[sampleIndex], vmlaq_u16(vmulq_u16(upper, upperWeight), lower, lowerWeight));
+	}
+#endif
+
+	for (; sampleIndex < count; ++sampleIndex)
+	{
+		u32 right = pWeightsX[sampleIndex];
+		u32 upper = (pCorners[0][sampleIndex] * (256u - right) + pCorners[1][sampleIndex] * right + 128u) >> 8;
+		u32 lower = (pCorners[2][sampleIndex] * (256u - right) + pCorners[3][sampleIndex] * right + 128u) >> 8;
+		pResult[sampleIndex] = (u16)(upper * (256u - weightY) + lower * weightY);
+	}
+}
+
+/**
+ * Sample `count` times `pPixels`, the texels of the texture of `pSlot`, from (`u`, `v`) in steps of `uStep` along u,
+ * with bilinear filtering and repeat wrapping, the sampler state of the default renderer. The rows, the format and the
+ * columns are resolved once for the whole span, then every channel is filtered with `filterTexels` into `pChannels`.
+ * Channels missing from the format read as OpenGL does: `R8` is uploaded as `GL_ALPHA` and reads (0, 0, 0, value),
+ * `RGB8` reads an alpha of 255.
+ */
+static void sampleSpan(const SiTextureSlot* pSlot,
+					   const u8*			pPixels,
+					   f32					u,
+					   f32					v,
+					   f32					uStep,
+					   u32					count,
+					   u16					pChannels[4][SPAN_TEXELS])
+{
+	u32 width		  = pSlot->width;
+	u32 bytesPerPixel = getBytesPerPixel(pSlot->format);
+	u64 rowSize		  = (u64)width * bytesPerPixel;
+
+	f32		  y		  = v * (f32)pSlot->height - 0.5f;
+	f32		  floorY  = floorf(y);
+	u16		  weightY = (u16)((y - floorY) * 256.0f + 0.5f);
+	const u8* pTop	  = &pPixels[(u64)wrapCoordinate((i32)floorY, pSlot->height) * rowSize];
+	const u8* pBottom = &pPixels[(u64)wrapCoordinate((i32)floorY + 1, pSlot->height) * rowSize];
+
+	u32 lefts[SPAN_TEXELS];
+	u32 rights[SPAN_TEXELS];
+	u16 weightsX[SPAN_TEXELS];
+	for (u32 sampleIndex = 0u; sampleIndex < count; ++sampleIndex, u += uStep)
+	{
+		f32 x	   = u * (f32)width - 0.5f;
+		f32 floorX = floorf(x);
+		u32 left   = (u32)wrapCoordinate((i32)floorX, width);
+
+		lefts[sampleIndex]	  = left * bytesPerPixel;
+		rights[sampleIndex]	  = (left + 1u == width ? 0u : left + 1u) * bytesPerPixel;
+		weightsX[sampleIndex] = (u16)((x - floorX) * 256.0f + 0.5f);
+	}
+
+	// The single channel of `R8` is the alpha, the other formats start with red.
+	u32 firstChannel = pSlot->format == SI_TEXTURE_FORMAT_R8 ? 3u : 0u;
+	for (u32 channel = 0u; channel < bytesPerPixel; ++channel)
+	{
+		u16 corners[4][SPAN_TEXELS];
+		for (u32 sampleIndex = 0u; sampleIndex < count; ++sampleIndex)
+		{
+			corners[0][sampleIndex] = pTop[lefts[sampleIndex] + channel];
+			corners[1][sampleIndex] = pTop[rights[sampleIndex] + channel];
+			corners[2][sampleIndex] = pBottom[lefts[sampleIndex] + channel];
+			corners[3][sampleIndex] = pBottom[rights[sampleIndex] + channel];
+		}
+
+		filterTexels(corners, weightsX, weightY, count, pChannels[firstChannel + channel]);
+	}
+
+	if (pSlot->format == SI_TEXTURE_FORMAT_R8)
+	{
+		memset(pChannels[0], 0, sizeof(u16) * count);
+		memset(pChannels[1], 0, sizeof(u16) * count);
+		memset(pChannels[2], 0, sizeof(u16) * count);
+	}
+	else if (pSlot->format == SI_TEXTURE_FORMAT_RGB8)
+	{
+		for (u32 sampleIndex = 0u; sampleIndex < count; ++sampleIndex)
+		{
+			pChannels[3][sampleIndex] = 255u << 8;
+		}
+	}
+}
+
+/**
+ * Signed distance from (`x`, `y`) to the border of a box centered at the origin with rounded corners, as in
+ * `rounded.frag`.
+ */
+static f32 roundedBoxDistance(f32 x, f32 y, f32 halfWidth, f32 halfHeight, f32 radius)
+{
+	f32 qx = fabsf(x) - halfWidth + radius;
+	f32 qy = fabsf(y) - halfHeight + radius;
+	f32 ox = qx > 0.0f ? qx : 0.0f;
+	f32 oy = qy > 0.0f ? qy : 0.0f;
+	f32 in = qx > qy ? qx : qy;
+	return sqrtf(ox * ox + oy * oy) + (in < 0.0f ? in : 0.0f) - radius;
+}
+
+static f32 saturate(f32 value)
+{
+	return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+}
+
+static u32 toChannel(f32 value)
+{
+	return value <= 0.0f ? 0u : (value >= 255.0f ? 255u : (u32)(value + 0.5f));
+}
+
+/**
+ * Shade `count` pixels of `row` starting at `column`, for the rectangle of `pCommand` centered at (`centerX`,
+ * `centerY`) in drawing coordinates. The pixels are sampled at their centers, like the fragments of the GPU.
+ */
+static void shadeSpan(const SoftwareCommand* pCommand,
+					  f32					 centerX,
+					  f32					 centerY,
+					  i32					 row,
+					  i32					 column,
+					  u32					 count,
+					  u32*					 pSource)
+{
+	const DrawRectangleParameter* pParams = &pCommand->params;
+	const SiColor*				  pColor  = &pParams->color;
+
+	f32 halfWidth  = pParams->width / 2.0f;
+	f32 halfHeight = pParams->height / 2.0f;
+	f32 localX	   = (f32)(2 * column + 1) - centerX;
+	f32 localY	   = (f32)(2 * ((i32)gSoftwareRendererData.height - row) - 1) - centerY;
+
+	if (pCommand->shader == SOFTWARE_SHADER_COLOR)
+	{
+		f32 radius = pParams->cornerRadius < halfWidth ? pParams->cornerRadius : halfWidth;
+		radius	   = radius < halfHeight ? radius : halfHeight;
+		radius	   = radius > 0.0f ? radius : 0.0f;
+
+		for (u32 pixelIndex = 0u; pixelIndex < count; ++pixelIndex, localX += 2.0f)
+		{
+			// A pixel is 2 drawing units wide, the neighbors stand in for `fwidth`.
+			f32 dist	 = roundedBoxDistance(localX, localY, halfWidth, halfHeight, radius);
+			f32 distX	 = roundedBoxDistance(localX + 2.0f, localY, halfWidth, halfHeight, radius);
+			f32 distY	 = roundedBoxDistance(localX, localY - 2.0f, halfWidth, halfHeight, radius);
+			f32 aa		 = fabsf(distX - dist) + fabsf(distY - dist);
+			aa			 = aa > 1e-4f ? aa : 1e-4f;
+			f32 coverage = saturate(0.5f - dist / aa);
+			if (pParams->borderWidth > 0.0f)
+			{
+				coverage *= saturate(0.5f + (dist + pParams->borderWidth) / aa);
+			}
+
+			pSource[pixelIndex] = packPixel(pColor->r, pColor->g, pColor->b, toChannel(pColor->a * coverage));
+		}
+		return;
+	}
+
+	const SiSprite*		 pSprite = &pParams->sprite;
+	const SiTextureSlot* pSlot	 = siGetTextureSlot(pSprite->texture);
+	const u8*			 pPixels = *getTexturePixels(pSprite->texture);
+
+	// The coordinates step once per pixel, 2 drawing units. The top of the rectangle samples `quadMin.y` and its bottom
+	// `quadMax.y`.
+	f32 uStep = (pSprite->quadMax.x - pSprite->quadMin.x) * 2.0f / pParams->width;
+	f32 vStep = (pSprite->quadMax.y - pSprite->quadMin.y) * 2.0f / pParams->height;
+	f32 u	  = pSprite->quadMin.x + (localX + halfWidth) / 2.0f * uStep;
+	f32 v	  = pSprite->quadMin.y + (halfHeight - localY) / 2.0f * vStep;
+
+	// The SDF shader compares every pixel with the next one, which is sampled one past the end of the span.
+	u16 texels[4][SPAN_TEXELS];
+	sampleSpan(pSlot, pPixels, u, v, uStep, pCommand->shader == SOFTWARE_SHADER_TEXT_SDF ? count + 1u : count, texels);
+
+	// The filtered channels are 256 times the texel, the color channels are divided by 255.
+	f32 scale = 1.0f / (256.0f * 255.0f);
+
+	switch (pCommand->shader)
+	{
+	case SOFTWARE_SHADER_TEXTURE:
+		for (u32 pixelIndex = 0u; pixelIndex < count; ++pixelIndex)
+		{
+			pSource[pixelIndex] = packPixel(toChannel(texels[0][pixelIndex] * pColor->r * scale),
+											toChannel(texels[1][pixelIndex] * pColor->g * scale),
+											toChannel(texels[2][pixelIndex] * pColor->b * scale),
+											toChannel(texels[3][pixelIndex] * pColor->a * scale));
+		}
+		break;
+	case SOFTWARE_SHADER_TEXT:
+		for (u32 pixelIndex = 0u; pixelIndex < count; ++pixelIndex)
+		{
+			u32 alpha			= toChannel(texels[3][pixelIndex] * pColor->a * scale);
+			pSource[pixelIndex] = packPixel(pColor->r, pColor->g, pColor->b, alpha);
+		}
+		break;
+	default:
+	{
+		u16 below[4][SPAN_TEXELS];
+		sampleSpan(pSlot, pPixels, u, v + vStep, uStep, count, below);
+
+		for (u32 pixelIndex = 0u; pixelIndex < count; ++pixelIndex)
+		{
+			f32 texel	 = texels[3][pixelIndex];
+			f32 dist	 = texel / 65280.0f;
+			f32 aa		 = (fabsf(texels[3][pixelIndex + 1u] - texel) + fabsf(below[3][pixelIndex] - texel)) / 65280.0f;
+			aa			 = aa > 1e-4f ? aa : 1e-4f;
+			f32 t		 = saturate((dist - (0.5f - aa)) / (2.0f * aa));
+			f32 coverage = t * t * (3.0f - 2.0f * t);
+
+			pSource[pixelIndex] = packPixel(pColor->r, pColor->g, pColor->b, toChannel(pColor->a * coverage));
+		}
+		break;
+	}
+	}
+}
+
+/**
+ * Blend the rectangle of `pCommand`, moved by `offset`, into the pixels of `pClip`. A pixel is covered when its center
+ * is inside the rectangle, the rasterization rule of the GPU.
+ */
+static void rasterizeRectangle(const SoftwareCommand* pCommand, SiVector2 offset, const i32 pClip[4])
+{
+	const DrawRectangleParameter* pParams = &pCommand->params;
+	SoftwareRendererData*		  pData	  = &gSoftwareRendererData;
+
+	f32 centerX = pParams->x + offset.x;
+	f32 centerY = pParams->y + offset.y;
+	f32 left	= (centerX - pParams->width / 2.0f) / 2.0f;
+	f32 right	= (centerX + pParams->width / 2.0f) / 2.0f;
+	f32 top		= (f32)pData->height - (centerY + pParams->height / 2.0f) / 2.0f;
+	f32 bottom	= (f32)pData->height - (centerY - pParams->height / 2.0f) / 2.0f;
+
+	f32 firstColumn = ceilf(left - 0.5f);
+	f32 endColumn	= ceilf(right - 0.5f);
+	f32 firstRow	= ceilf(top - 0.5f);
+	f32 endRow		= ceilf(bottom - 0.5f);
+
+	i32 column0 = firstColumn > (f32)pClip[0] ? (i32)firstColumn : pClip[0];
+	i32 column1 = endColumn < (f32)pClip[2] ? (i32)endColumn : pClip[2];
+	i32 row0	= firstRow > (f32)pClip[1] ? (i32)firstRow : pClip[1];
+	i32 row1	= endRow < (f32)pClip[3] ? (i32)endRow : pClip[3];
+	if (column0 >= column1 || row0 >= row1 || pParams->color.a == 0u)
+	{
+		return;
+	}
+
+	// The texture can be destroyed between recording and rasterization, by `siCancelImage` or before a draw list
+	// replay, its pixels are freed then.
+	if (pCommand->shader != SOFTWARE_SHADER_COLOR && !siIsTextureAlive(pParams->sprite.texture))
+	{
+		return;
+	}
+
+	u32 source[SPAN_PIXELS];
+
+	// Square, untextured rectangles have the same color on every pixel, which is packed once.
+	b8 isFlat = pCommand->shader == SOFTWARE_SHADER_COLOR && pParams->cornerRadius <= 0.0f &&
+				pParams->borderWidth <= 0.0f;
+	if (isFlat)
+	{
+		u32 pixel = packPixel(pParams->color.r, pParams->color.g, pParams->color.b, pParams->color.a);
+		for (u32 pixelIndex = 0u; pixelIndex < SPAN_PIXELS; ++pixelIndex)
+		{
+			source[pixelIndex] = pixel;
+		}
+	}
+
+	for (i32 row = row0; row < row1; ++row)
+	{
+		u32* pRow = &pData->pFramebuffer[(u64)row * pData->width];
+
+		for (i32 column = column0; column < column1; column += (i32)SPAN_PIXELS)
+		{
+			u32 count = (u32)(column1 - column) < SPAN_PIXELS ? (u32)(column1 - column) : SPAN_PIXELS;
+
+			if (isFlat && pParams->color.a == 255u)
+			{
+				memcpy(&pRow[column], source, sizeof(u32) * count);
+				continue;
+			}
+
+			if (!isFlat)
+			{
+				shadeSpan(pCommand, centerX, centerY, row, column, count, source);
+			}
+			blendSpan(&pRow[column], source, count);
+		}
+	}
+}
+
+// =========================== Blending ===========================
+/**
+ * Pack the channels into the 4 bytes of an RGBA8 pixel, in memory order whatever the endianness.
+ */
+static u32 packPixel(u32 r, u32 g, u32 b, u32 a)
+{
+	u8	bytes[4] = {(u8)r, (u8)g, (u8)b, (u8)a};
+	u32 pixel;
+	memcpy(&pixel, bytes, sizeof(pixel));
+	return pixel;
+}
+
+/**
+ * `glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)` on one channel, rounded to the nearest value. The sum is divided
+ * by 255 with `(t + (t >> 8)) >> 8`, which the SIMD paths compute exactly the same way.
+ */
+static u8 blendChannel(u32 source, u32 destination, u32 alpha)
+{
+	u32 sum = source * alpha + destination * (255u - alpha) + 128u;
+	return (u8)((sum + (sum >> 8)) >> 8);
+}
+
+#ifdef SOFTWARE_USE_SSE2
+/**
+ * Blend two pixels unpacked to 16 bits per channel.
+ */
+static __m128i blendPixelsSse2(__m128i source, __m128i destination)
+{
+	// Alpha is the 4th 16-bit lane of each pixel, broadcast to the lanes of its pixel.
+	__m128i alpha	= _mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3));
+	alpha			= _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+	__m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+	__m128i sum		= _mm_add_epi16(_mm_mullo_epi16(source, alpha), _mm_mullo_epi16(destination, inverse));
+	sum				= _mm_add_epi16(sum, _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(sum, _mm_srli_epi16(sum, 8)), 8);
+}
+#endif // SOFTWARE_USE_SSE2
+
+/**
+ * Blend `count` pixels of `pSource` over `pDestination` with the alpha of the source, on every channel like the
+ * default renderer. The SSE2 and NEON paths blend 4 and 8 pixels at a time and round like `blendChannel`, so the image
+ * does not depend on the instruction set.
+ */
+static void blendSpan(u32* pDestination, const u32* pSource, u32 count)
+{
+	u32 pixelIndex = 0u;
+
+#if defined(SOFTWARE_USE_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; pixelIndex + 4u <= count; pixelIndex += 4u)
+	{
+		__m128i source		= _mm_loadu_si128((const __m128i*)&pSource[pixelIndex]);
+		__m128i destination = _mm_loadu_si128((const __m128i*)&pDestination[pixelIndex]);
+
+		__m128i low	 = blendPixelsSse2(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(destination, zero));
+		__m128i high = blendPixelsSse2(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(destination, zero));
+		_mm_storeu_si128((__m128i*)&pDestination[pixelIndex], _mm_packus_epi16(low, high));
+	}
+#elif defined(SOFTWARE_USE_NEON)
+	const uint16x8_t half = vdupq_n_u16(128);
+	for (; pixelIndex + 8u <= count; pixelIndex += 8u)
+	{
+		// De-interleaved into one register per channel.
+		uint8x8x4_t source		= vld4_u8((const u8*)&pSource[pixelIndex]);
+		uint8x8x4_t destination = vld4_u8((const u8*)&pDestination[pixelIndex]);
+		uint8x8_t	alpha		= source.val[3];
+		uint8x8_t	inverse		= vmvn_u8(alpha);
+
+		for (u32 channel = 0u; channel < 4u; ++channel)
+		{
+			uint16x8_t sum = vmlal_u8(vmull_u8(source.val[channel], alpha), destination.val[channel], inverse);
+			sum			   = vaddq_u16(sum, half);
+			destination.val[channel] = vshrn_n_u16(vsraq_n_u16(sum, sum, 8), 8);
+		}
+		vst4_u8((u8*)&pDestination[pixelIndex], destination);
+	}
+#endif
+
+	for (; pixelIndex < count; ++pixelIndex)
+	{
+		u8 source[4];
+		u8 destination[4];
+		memcpy(source, &pSource[pixelIndex], sizeof(source));
+		memcpy(destination, &pDestination[pixelIndex], sizeof(destination));
+
+		for (u32 channel = 0u; channel < 4u; ++channel)
+		{
+			destination[channel] = blendChannel(source[channel], destination[channel], source[3]);
+		}
+		memcpy(&pDestination[pixelIndex], destination, sizeof(destination));
+	}
+}
+
+// =========================== Framebuffer ===========================
+void siResizeSoftwareFramebuffer(u32 width, u32 height)
+{
+	if (width == 0u || height == 0u)
+	{
+		SI_ERROR_EXIT("Invalid software framebuffer size %ux%u.", width, height);
+	}
+
+	siAcquireRenderContext();
+	u32* pFramebuffer = (u32*)realloc(gSoftwareRendererData.pFramebuffer, sizeof(u32) * width * height);
+	if (pFramebuffer == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate a software framebuffer of %ux%u pixels.", width, height);
+	}
+
+	clearFramebuffer(pFramebuffer, (u64)width * height);
+	gSoftwareRendererData.pFramebuffer = pFramebuffer;
+	gSoftwareRendererData.width		   = width;
+	gSoftwareRendererData.height	   = height;
+	siReleaseRenderContext();
+}
+
+const u8* siGetSoftwareFramebuffer(u32* pWidth, u32* pHeight)
+{
+	if (pWidth != SI_NULL)
+	{
+		*pWidth = gSoftwareRendererData.width;
+	}
+
+	if (pHeight != SI_NULL)
+	{
+		*pHeight = gSoftwareRendererData.height;
+	}
+
+	return (const u8*)gSoftwareRendererData.pFramebuffer;
+}
+
+b8 siWriteSoftwareFramebufferRaw(const char* filePath)
+{
+	FILE* pFile = fopen(filePath, "wb");
+	if (pFile == SI_NULL)
+	{
+		siPrintWarning("Failed to open %s to write the software framebuffer.", filePath);
+		return SI_FALSE;
+	}
+
+	u64 pixelCount = (u64)gSoftwareRendererData.width * gSoftwareRendererData.height;
+	u64 written	   = fwrite(gSoftwareRendererData.pFramebuffer, sizeof(u32), pixelCount, pFile);
+	fclose(pFile);
+
+	if (written != pixelCount)
+	{
+		siPrintWarning("Failed to write the software framebuffer to %s.", filePath);
+		return SI_FALSE;
+	}
+
+	return SI_TRUE;
+}
+
+#ifdef SIMUI_USE_STB
+b8 siWriteSoftwareFramebufferPng(const char* filePath)
+{
+	u32 width  = gSoftwareRendererData.width;
+	u32 height = gSoftwareRendererData.height;
+
+	if (!stbi_write_png(filePath, (int)width, (int)height, 4, gSoftwareRendererData.pFramebuffer, (int)(width * 4u)))
+	{
+		siPrintWarning("Failed to write the software framebuffer to %s.", filePath);
+		return SI_FALSE;
+	}
+
+	return SI_TRUE;
+}
+#endif // SIMUI_USE_STB
+
+// =========================== Textures ===========================
+static u32 getBytesPerPixel(SiTextureFormat format)
+{
+	switch (format)
+	{
+	case SI_TEXTURE_FORMAT_RGBA8:
+		return 4u;
+	case SI_TEXTURE_FORMAT_RGB8:
+		return 3u;
+	case SI_TEXTURE_FORMAT_R8:
+		return 1u;
+	default:
+		SI_ERROR_EXIT("Unsupported texture format.");
+		return 1u;
+	}
+}
+
+/**
+ * Copy a region of `width` x `height` tightly packed texels into `texture`.
+ */
+static void copyTextureRegion(SiTexture texture, u32 x, u32 y, u32 width, u32 height, const u8* pData)
+{
+	const SiTextureSlot* pSlot	 = siGetTextureSlot(texture);
+	u8*					 pPixels = *getTexturePixels(texture);
+	if (x + width > pSlot->width || y + height > pSlot->height)
+	{
+		SI_ERROR_EXIT("Texture region %ux%u at (%u, %u) is outside of the texture.", width, height, x, y);
+	}
+
+	u32 bytesPerPixel = getBytesPerPixel(pSlot->format);
+	for (u32 row = 0u; row < height; ++row)
+	{
+		memcpy(&pPixels[((u64)(y + row) * pSlot->width + x) * bytesPerPixel],
+			   &pData[(u64)row * width * bytesPerPixel],
+			   (u64)width * bytesPerPixel);
+	}
+}
+
+SiTexture siCreateTexture(u32 width, u32 height, SiTextureFormat format, const void* pData)
+{
+	// The slots are shared with the render thread, which creates the glyph atlas pages.
+	siAcquireRenderContext();
+
+	SiTexture texture  = siAllocateTextureSlot(width, height, format);
+	u8**	  ppPixels = getTexturePixels(texture);
+	*ppPixels		   = (u8*)calloc((u64)width * height, getBytesPerPixel(format));
+	if (*ppPixels == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate a %ux%u texture.", width, height);
+	}
+
+	if (pData != SI_NULL)
+	{
+		copyTextureRegion(texture, 0u, 0u, width, height, (const u8*)pData);
+	}
+	siReleaseRenderContext();
+
+	return texture;
+}
+
+void siUpdateTexture(SiTexture texture, u32 x, u32 y, u32 width, u32 height, const void* pData)
+{
+	siValidateTexture(texture);
+
+	// Waits for the frame being rasterized, which may sample the texture.
+	siAcquireRenderContext();
+	copyTextureRegion(texture, x, y, width, height, (const u8*)pData);
+	siReleaseRenderContext();
+}
+
+void* siMapTextureRegion(SiTexture texture, u32 x, u32 y, u32 width, u32 height)
+{
+	siValidateTexture(texture);
+	SiTextureSlot* pSlot = siGetTextureSlot(texture);
+
+	if (gSoftwareRendererData.mappedTexture != SI_TEXTURE_NULL)
+	{
+		SI_ERROR_EXIT("siMapTextureRegion called while another region is mapped, siUnmapTextureRegion is missing.");
+	}
+
+	// The context stays with the calling thread until the region is unmapped.
+	siAcquireRenderContext();
+	gSoftwareRendererData.mappedTexture	  = texture;
+	gSoftwareRendererData.mappedRegion[0] = x;
+	gSoftwareRendererData.mappedRegion[1] = y;
+	gSoftwareRendererData.mappedRegion[2] = width;
+	gSoftwareRendererData.mappedRegion[3] = height;
+
+	gSoftwareRendererData.pMappedPixels = (u8*)malloc((u64)width * height * getBytesPerPixel(pSlot->format));
+	if (gSoftwareRendererData.pMappedPixels == SI_NULL)
+	{
+		SI_ERROR_EXIT("Failed to allocate a %ux%u texture region.", width, height);
+	}
+
+	return gSoftwareRendererData.pMappedPixels;
+}
+
+void siUnmapTextureRegion(SiTexture texture)
+{
+	siValidateTexture(texture);
+
+	if (gSoftwareRendererData.mappedTexture != texture)
+	{
+		SI_ERROR_EXIT("siUnmapTextureRegion called without siMapTextureRegion.");
+	}
+
+	u32* pRegion = gSoftwareRendererData.mappedRegion;
+	copyTextureRegion(texture, pRegion[0], pRegion[1], pRegion[2], pRegion[3], gSoftwareRendererData.pMappedPixels);
+
+	free(gSoftwareRendererData.pMappedPixels);
+	gSoftwareRendererData.pMappedPixels = SI_NULL;
+	gSoftwareRendererData.mappedTexture = SI_TEXTURE_NULL;
+	siReleaseRenderContext();
+}
+
+void siDestroyTexture(SiTexture texture)
+{
+	siValidateTexture(texture);
+
+	siAcquireRenderContext();
+
+	u8** ppPixels = getTexturePixels(texture);
+	free(*ppPixels);
+	*ppPixels = SI_NULL;
+	siReleaseTextureSlot(texture);
+
+	siReleaseRenderContext();
+}
+
+#endif // SIMUI_USE_SOFTWARE_RENDERER
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "simui/texture_cache.h"
+#include "simui/simui.h"
+#include <string.h>
+
+#define TEXTURE_CACHE_MAGIC	  0x58455453u ///< "STEX" read as a little endian u32.
+#define TEXTURE_CACHE_VERSION 1u
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ull
+#define FNV_PRIME		 0x100000001b3ull
+
+/**
+ * Header of a `.simtex` file, followed by the tightly packed pixels of the image. The file is written in the byte order
+ * of the machine, a cache file copied to a machine of the other byte order fails the magic check and is rebuilt.
+ */
+typedef struct TextureCacheHeader
+{
+	u32 magic;				///< `TEXTURE_CACHE_MAGIC`.
+	u32 version;			///< `TEXTURE_CACHE_VERSION`, bumped when the layout changes.
+	u64 pathHash;			///< FNV-1a of the image path, against collisions of the file names.
+	u64 sourceSize;			///< Size of the image file the pixels were decoded from.
+	u64 sourceModifiedTime; ///< Modification time of the image file, see `siGetFileInfo`.
+	u32 width;
+	u32 height;
+	u32 format; ///< The `SiTextureFormat` of the pixels.
+	u32 reserved;
+} TextureCacheHeader;
+
+static char gTextureCacheDirectory[SI_TEXTURE_CACHE_PATH_SIZE] = {0};
+
+static u64 hashPath(const char* filePath)
+{
+	u64 hash = FNV_OFFSET_BASIS;
+	for (const char* pCharacter = filePath; *pCharacter != '\0'; ++pCharacter)
+	{
+		hash ^= (u8)*pCharacter;
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+static u64 getPixelsSize(u32 width, u32 height, SiTextureFormat format)
+{
+	u64 bytesPerPixel = format == SI_TEXTURE_FORMAT_RGBA8 ? 4u : (format == SI_TEXTURE_FORMAT_RGB8 ? 3u : 1u);
+	return (u64)width * height * bytesPerPixel;
+}
+
+/**
+ * Fill the part of `header` describing the image at `filePath` and the path of its cache file.
+ *
+ * @return `SI_FALSE` if the cache is disabled or the image file does not exist.
+ */
+static b8 describeSource(const char* filePath, TextureCacheHeader* pHeader, char* cachePath)
+{
+	if (gTextureCacheDirectory[0] == '\0')
+	{
+		return SI_FALSE;
+	}
+
+	memset(pHeader, 0, sizeof(TextureCacheHeader));
+	if (!siGetFileInfo(filePath, &pHeader->sourceSize, &pHeader->sourceModifiedTime))
+	{
+		return SI_FALSE;
+	}
+
+	pHeader->pathHash = hashPath(filePath);
+	siStringFormat(cachePath,
+				   SI_TEXTURE_CACHE_PATH_SIZE,
+				   "%s/%016llx" SI_TEXTURE_CACHE_EXTENSION,
+				   gTextureCacheDirectory,
+				   (unsigned long long)pHeader->pathHash);
+	return SI_TRUE;
+}
+
+void siSetTextureCacheDirectory(const char* directory)
+{
+	if (directory == SI_NULL)
+	{
+		gTextureCacheDirectory[0] = '\0';
+		return;
+	}
+
+	if (strlen(directory) >= SI_TEXTURE_CACHE_PATH_SIZE - 32u)
+	{
+		SI_ERROR_EXIT("Texture cache directory path too long: %s", directory);
+	}
+
+	siStringFormat(gTextureCacheDirectory, SI_TEXTURE_CACHE_PATH_SIZE, "%s", directory);
+}
+
+SiTexture siLoadCachedTexture(const char* filePath)
+{
+	TextureCacheHeader source;
+	char			   cachePath[SI_TEXTURE_CACHE_PATH_SIZE];
+	if (!describeSource(filePath, &source, cachePath))
+	{
+		return SI_TEXTURE_NULL;
+	}
+
+	SiMappedFile file;
+	if (!siMapFile(cachePath, &file))
+	{
+		return SI_TEXTURE_NULL;
+	}
+
+	SiTexture				  texture = SI_TEXTURE_NULL;
+	const TextureCacheHeader* pHeader = (const TextureCacheHeader*)file.pData;
+	if (file.size >= sizeof(TextureCacheHeader) && pHeader->magic == TEXTURE_CACHE_MAGIC &&
+		pHeader->version == TEXTURE_CACHE_VERSION && pHeader->pathHash == source.pathHash &&
+		pHeader->sourceSize == source.sourceSize && pHeader->sourceModifiedTime == source.sourceModifiedTime &&
+		pHeader->format <= SI_TEXTURE_FORMAT_R8 &&
+		file.size == sizeof(TextureCacheHeader) + getPixelsSize(pHeader->width, pHeader->height, pHeader->format))
+	{
+		texture = siCreateTexture(
+			pHeader->width, pHeader->height, (SiTextureFormat)pHeader->format, file.pData + sizeof(TextureCacheHeader));
+	}
+
+	siUnmapFile(&file);
+	return texture;
+}
+
+void siStoreCachedTexture(const char* filePath, u32 width, u32 height, SiTextureFormat format, const void* pPixels)
+{
+	TextureCacheHeader header;
+	char			   cachePath[SI_TEXTURE_CACHE_PATH_SIZE];
+	if (!describeSource(filePath, &header, cachePath))
+	{
+		return;
+	}
+
+	header.magic   = TEXTURE_CACHE_MAGIC;
+	header.version = TEXTURE_CACHE_VERSION;
+	header.width   = width;
+	header.height  = height;
+	header.format  = (u32)format;
+
+	u64 pixelsSize = getPixelsSize(width, height, format);
+	if (!siWriteFileAtomic(cachePath, &header, sizeof(TextureCacheHeader), pPixels, pixelsSize))
+	{
+		siPrintWarning("Failed to write texture cache file: %s", cachePath);
+	}
+}
\ No newline at end of file
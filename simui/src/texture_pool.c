@@ -0,0 +1,214 @@
+#include "simui/texture_pool.h"
+#include "simui/simui.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TEXTURE_SLOTS_PER_PAGE 1024u
+#define MAX_TEXTURE_PAGES	   ((SI_TEXTURE_INDEX_MASK + 1u) / TEXTURE_SLOTS_PER_PAGE)
+#define TEXTURE_INDEX_NONE	   ((u32) - 1)
+
+/**
+ * The slots and the backend data are paged alike, the data of a slot sits at the same index of its own page. Destroyed
+ * slots are queued into a free list, which makes creating and destroying a texture O(1). The list is first in first
+ * out, so the generations of all the free slots are bumped in turn instead of wrapping a single reused slot around.
+ */
+static SiTextureSlot* gpTextureSlotPages[MAX_TEXTURE_PAGES];
+static u8*			  gpTextureDataPages[MAX_TEXTURE_PAGES];
+static u32			  gTextureDataSize	= 0u;				  ///< The bytes of backend data per slot.
+static u32			  gTextureSlotCount = 0u;				  ///< The number of slots handed out so far.
+static u32			  gFirstFreeTexture = TEXTURE_INDEX_NONE; ///< The head of the free list, reused first.
+static u32			  gLastFreeTexture	= TEXTURE_INDEX_NONE; ///< The tail of the free list, destroyed last.
+
+static SiTextureSlot* getSlot(u32 textureIndex)
+{
+	return &gpTextureSlotPages[textureIndex / TEXTURE_SLOTS_PER_PAGE][textureIndex % TEXTURE_SLOTS_PER_PAGE];
+}
+
+static void* getSlotData(u32 textureIndex)
+{
+	u8* pPage = gpTextureDataPages[textureIndex / TEXTURE_SLOTS_PER_PAGE];
+	return &pPage[(u64)(textureIndex % TEXTURE_SLOTS_PER_PAGE) * gTextureDataSize];
+}
+
+void siInitializeTexturePool(u32 dataSize)
+{
+	memset(gpTextureSlotPages, 0, sizeof(gpTextureSlotPages));
+	memset(gpTextureDataPages, 0, sizeof(gpTextureDataPages));
+	gTextureDataSize  = dataSize;
+	gTextureSlotCount = 0u;
+	gFirstFreeTexture = TEXTURE_INDEX_NONE;
+	gLastFreeTexture  = TEXTURE_INDEX_NONE;
+}
+
+void siShutdownTexturePool()
+{
+	for (u32 textureIndex = 0u; textureIndex < gTextureSlotCount; ++textureIndex)
+	{
+		SiTextureSlot* pSlot = getSlot(textureIndex);
+		if (pSlot->isUsed)
+		{
+			siDestroyTexture(textureIndex | (pSlot->generation << SI_TEXTURE_INDEX_BITS));
+		}
+	}
+
+	for (u32 pageIndex = 0u; pageIndex < MAX_TEXTURE_PAGES; ++pageIndex)
+	{
+		free(gpTextureSlotPages[pageIndex]);
+		free(gpTextureDataPages[pageIndex]);
+	}
+	siInitializeTexturePool(0u);
+}
+
+SiTexture siAllocateTextureSlot(u32 width, u32 height, SiTextureFormat format)
+{
+	// Reuse the slot destroyed the longest ago, or else hand out a new one.
+	u32 textureIndex = gFirstFreeTexture;
+	if (textureIndex != TEXTURE_INDEX_NONE)
+	{
+		gFirstFreeTexture = getSlot(textureIndex)->nextFree;
+		if (gFirstFreeTexture == TEXTURE_INDEX_NONE)
+		{
+			gLastFreeTexture = TEXTURE_INDEX_NONE;
+		}
+	}
+	else
+	{
+		// The last index is left out so that no handle can be equal to `SI_TEXTURE_NULL`.
+		if (gTextureSlotCount == SI_TEXTURE_INDEX_MASK)
+		{
+			SI_ERROR_EXIT("Too many textures, %u slots are alive or retired.", gTextureSlotCount);
+		}
+
+		textureIndex  = gTextureSlotCount++;
+		u32 pageIndex = textureIndex / TEXTURE_SLOTS_PER_PAGE;
+		if (gpTextureSlotPages[pageIndex] == SI_NULL)
+		{
+			gpTextureSlotPages[pageIndex] = (SiTextureSlot*)calloc(TEXTURE_SLOTS_PER_PAGE, sizeof(SiTextureSlot));
+			if (gpTextureSlotPages[pageIndex] == SI_NULL)
+			{
+				SI_ERROR_EXIT("Failed to allocate texture slot page %u.", pageIndex);
+			}
+		}
+
+		if (gTextureDataSize != 0u && gpTextureDataPages[pageIndex] == SI_NULL)
+		{
+			gpTextureDataPages[pageIndex] = (u8*)calloc(TEXTURE_SLOTS_PER_PAGE, gTextureDataSize);
+			if (gpTextureDataPages[pageIndex] == SI_NULL)
+			{
+				SI_ERROR_EXIT("Failed to allocate texture data page %u.", pageIndex);
+			}
+		}
+	}
+
+	SiTextureSlot* pSlot	  = getSlot(textureIndex);
+	u32			   generation = pSlot->generation;
+	memset(pSlot, 0, sizeof(SiTextureSlot));
+	if (gTextureDataSize != 0u)
+	{
+		memset(getSlotData(textureIndex), 0, gTextureDataSize);
+	}
+
+	pSlot->width	  = width;
+	pSlot->height	  = height;
+	pSlot->format	  = format;
+	pSlot->isUsed	  = SI_TRUE;
+	pSlot->generation = generation;
+	pSlot->nextFree	  = TEXTURE_INDEX_NONE;
+
+	return textureIndex | (generation << SI_TEXTURE_INDEX_BITS);
+}
+
+void siReleaseTextureSlot(SiTexture texture)
+{
+	u32			   textureIndex = SI_TEXTURE_INDEX(texture);
+	SiTextureSlot* pSlot		= getSlot(textureIndex);
+	pSlot->isUsed				= SI_FALSE;
+	pSlot->generation++;
+	pSlot->nextFree = TEXTURE_INDEX_NONE;
+
+	// A wrapped generation would make the oldest handles to the slot valid again, so the slot is retired instead.
+	if (pSlot->generation == SI_TEXTURE_GENERATION_MASK)
+	{
+		return;
+	}
+
+	if (gLastFreeTexture != TEXTURE_INDEX_NONE)
+	{
+		getSlot(gLastFreeTexture)->nextFree = textureIndex;
+	}
+	else
+	{
+		gFirstFreeTexture = textureIndex;
+	}
+	gLastFreeTexture = textureIndex;
+}
+
+void siValidateTexture(SiTexture texture)
+{
+	if (SI_TEXTURE_INDEX(texture) >= gTextureSlotCount)
+	{
+		SI_ERROR_EXIT("Invalid texture handle.");
+	}
+
+	if (!getSlot(SI_TEXTURE_INDEX(texture))->isUsed)
+	{
+		SI_ERROR_EXIT("Texture handle not in use.");
+	}
+
+	if (getSlot(SI_TEXTURE_INDEX(texture))->generation != SI_TEXTURE_GENERATION(texture))
+	{
+		SI_ERROR_EXIT("Stale texture handle, the texture was destroyed.");
+	}
+}
+
+b8 siIsTextureAlive(SiTexture texture)
+{
+	u32 textureIndex = SI_TEXTURE_INDEX(texture);
+	if (textureIndex >= gTextureSlotCount)
+	{
+		return SI_FALSE;
+	}
+
+	const SiTextureSlot* pSlot = getSlot(textureIndex);
+	return pSlot->isUsed && pSlot->generation == SI_TEXTURE_GENERATION(texture);
+}
+
+SiTextureSlot* siGetTextureSlot(SiTexture texture)
+{
+	return getSlot(SI_TEXTURE_INDEX(texture));
+}
+
+void* siGetTextureSlotData(SiTexture texture)
+{
+	return getSlotData(SI_TEXTURE_INDEX(texture));
+}
+
+#if SIMUI_USE_DEFAULT_RENDERER || SIMUI_USE_SOFTWARE_RENDERER
+// The size and format queries are the same for every backend built on the pool.
+SiVector2 siGetTextureSize(SiTexture texture)
+{
+	siValidateTexture(texture);
+	SiTextureSlot* pSlot = siGetTextureSlot(texture);
+	SiVector2	   size	 = {(f32)pSlot->width, (f32)pSlot->height};
+	return size;
+}
+
+SiVector2 siGetSpriteSize(SiSprite sprite)
+{
+	siValidateTexture(sprite.texture);
+	SiTextureSlot* pSlot	   = siGetTextureSlot(sprite.texture);
+	SiVector2	   textureSize = {(f32)pSlot->width, (f32)pSlot->height};
+
+	SiVector2 size;
+	size.x = (sprite.quadMax.x - sprite.quadMin.x) * textureSize.x;
+	size.y = (sprite.quadMax.y - sprite.quadMin.y) * textureSize.y;
+
+	return size;
+}
+
+SiTextureFormat siGetTextureFormat(SiTexture texture)
+{
+	siValidateTexture(texture);
+	return siGetTextureSlot(texture)->format;
+}
+#endif // SIMUI_USE_DEFAULT_RENDERER || SIMUI_USE_SOFTWARE_RENDERER